@@ -0,0 +1,106 @@
+#include "ApiEndpoints.h"
+#include "ConfigManager.h"
+#include "CategoryCache.h"
+
+#include <QUrl>
+
+using Priority = NetworkRequest::Priority;
+
+// Timeouts: channel reads poll the dock and give up early, user actions wait a little longer, and
+// the browser-only login pages never go through NetworkEngine. Writes that set absolute values are
+// idempotent; chat messages and token refreshes (which rotate the refresh token) are not.
+static constexpr EndpointSpec ENDPOINTS[] = {
+	{ApiEndpoint::TwitchAuthorize, "twitch/authorize", ApiBase::TwitchAuth, "/authorize", "GET", 0,
+	 Priority::Normal, false, 0},
+	{ApiEndpoint::TwitchValidate, "twitch/validate", ApiBase::TwitchAuth, "/validate", "GET", 10000,
+	 Priority::Normal, true, 0},
+	{ApiEndpoint::TwitchUsers, "twitch/users", ApiBase::TwitchApi, "/users", "GET", 10000, Priority::Normal, true,
+	 0},
+	{ApiEndpoint::TwitchGames, "twitch/games", ApiBase::TwitchApi, "/games", "GET", 10000, Priority::Normal, true,
+	 CategoryCache::DEFAULT_TTL_SECONDS},
+	{ApiEndpoint::TwitchChannel, "twitch/channels", ApiBase::TwitchApi, "/channels", "GET", 10000, Priority::Low,
+	 true, 0},
+	{ApiEndpoint::TwitchChannelUpdate, "twitch/channels.update", ApiBase::TwitchApi, "/channels", "PATCH", 15000,
+	 Priority::High, true, 0},
+	{ApiEndpoint::TwitchChatMessage, "twitch/chat.messages", ApiBase::TwitchApi, "/chat/messages", "POST", 15000,
+	 Priority::High, false, 0},
+	{ApiEndpoint::TrovoLogin, "trovo/login", ApiBase::TrovoAuth, "/page/login.html", "GET", 0, Priority::Normal,
+	 false, 0},
+	{ApiEndpoint::TrovoValidate, "trovo/validate", ApiBase::TrovoApi, "/validate", "GET", 10000, Priority::Normal,
+	 true, 0},
+	{ApiEndpoint::TrovoSearchCategory, "trovo/searchcategory", ApiBase::TrovoApi, "/searchcategory", "POST", 10000,
+	 Priority::Normal, true, CategoryCache::DEFAULT_TTL_SECONDS},
+	{ApiEndpoint::TrovoChannel, "trovo/channel", ApiBase::TrovoApi, "/channel", "GET", 10000, Priority::Low, true,
+	 0},
+	{ApiEndpoint::TrovoChannelUpdate, "trovo/channels.update", ApiBase::TrovoApi, "/channels/update", "POST", 15000,
+	 Priority::High, true, 0},
+	{ApiEndpoint::TrovoChatSend, "trovo/chat.send", ApiBase::TrovoApi, "/chat/send", "POST", 15000, Priority::High,
+	 false, 0},
+	{ApiEndpoint::TrovoTokenRefresh, "trovo/relay.refresh", ApiBase::TrovoRelay, "", "POST", 15000, Priority::High,
+	 false, 0},
+};
+
+static constexpr bool endpoints_in_order()
+{
+	for (size_t i = 0; i < sizeof(ENDPOINTS) / sizeof(ENDPOINTS[0]); ++i) {
+		if (static_cast<size_t>(ENDPOINTS[i].endpoint) != i)
+			return false;
+	}
+	return true;
+}
+
+static_assert(sizeof(ENDPOINTS) / sizeof(ENDPOINTS[0]) == static_cast<size_t>(ApiEndpoint::Count),
+	      "Every ApiEndpoint needs an entry in ENDPOINTS");
+static_assert(endpoints_in_order(), "ENDPOINTS must be listed in ApiEndpoint order");
+
+const EndpointSpec &ApiEndpoints::spec(ApiEndpoint endpoint)
+{
+	return ENDPOINTS[static_cast<int>(endpoint)];
+}
+
+QString ApiEndpoints::baseUrl(ApiBase base)
+{
+	ConfigManager &config = ConfigManager::get();
+	switch (base) {
+	case ApiBase::TwitchAuth:
+		return config.getTwitchAuthBaseUrl();
+	case ApiBase::TwitchApi:
+		return config.getTwitchApiBaseUrl();
+	case ApiBase::TrovoAuth:
+		return config.getTrovoAuthBaseUrl();
+	case ApiBase::TrovoApi:
+		return config.getTrovoApiBaseUrl();
+	case ApiBase::TrovoRelay:
+		return config.getTrovoRelayUrl();
+	}
+	return QString();
+}
+
+QString ApiEndpoints::url(ApiEndpoint endpoint, const QString &query)
+{
+	const EndpointSpec &endpointSpec = spec(endpoint);
+	QString result = baseUrl(endpointSpec.base) + endpointSpec.path;
+	if (!query.isEmpty())
+		result += "?" + query;
+	return result;
+}
+
+NetworkRequest ApiEndpoints::request(ApiEndpoint endpoint, const QString &query)
+{
+	const EndpointSpec &endpointSpec = spec(endpoint);
+	NetworkRequest request;
+	request.url = url(endpoint, query);
+	request.method = endpointSpec.method;
+	request.endpoint = endpointSpec.name;
+	request.timeoutMs = endpointSpec.timeoutMs;
+	request.priority = endpointSpec.priority;
+	request.idempotent = endpointSpec.idempotent;
+	bool twitch = endpointSpec.base == ApiBase::TwitchAuth || endpointSpec.base == ApiBase::TwitchApi;
+	request.circuit = circuit(twitch ? "Twitch" : "Trovo", request.url);
+	return request;
+}
+
+std::string ApiEndpoints::circuit(const QString &platform, const QString &url)
+{
+	return (platform + '/' + QUrl(url).host()).toStdString();
+}
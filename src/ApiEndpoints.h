@@ -0,0 +1,66 @@
+#ifndef APIENDPOINTS_H
+#define APIENDPOINTS_H
+
+#pragma once
+
+#include "NetworkEngine.h"
+
+#include <QString>
+
+#include <string>
+
+// Every platform API call the plugin makes. The table in ApiEndpoints.cpp holds where each one
+// lives and how it is scheduled, so URLs and request policy are not spread across the auth
+// managers.
+enum class ApiEndpoint {
+	TwitchAuthorize,
+	TwitchValidate,
+	TwitchUsers,
+	TwitchGames,
+	TwitchChannel,
+	TwitchChannelUpdate,
+	TwitchChatMessage,
+	TrovoLogin,
+	TrovoValidate,
+	TrovoSearchCategory,
+	TrovoChannel,
+	TrovoChannelUpdate,
+	TrovoChatSend,
+	TrovoTokenRefresh,
+	Count,
+};
+
+// Base URLs an endpoint path is appended to. Each one is resolved through ConfigManager, so it
+// can point at MockPlatformServer or another stand-in.
+enum class ApiBase { TwitchAuth, TwitchApi, TrovoAuth, TrovoApi, TrovoRelay };
+
+struct EndpointSpec {
+	ApiEndpoint endpoint;
+	// Stable name used as the endpoint label in metrics, independent of the base URL.
+	const char *name;
+	ApiBase base;
+	const char *path;
+	const char *method;
+	long timeoutMs;
+	NetworkRequest::Priority priority;
+	// Safe to send again after a transport error, 429 or 5xx.
+	bool idempotent;
+	// How long a successful lookup may be served from a local cache. 0 when it is never cached.
+	qint64 cacheTtlSeconds;
+};
+
+class ApiEndpoints {
+public:
+	static const EndpointSpec &spec(ApiEndpoint endpoint);
+	static QString baseUrl(ApiBase base);
+	// Full URL of the endpoint. query is appended after a '?' when not empty.
+	static QString url(ApiEndpoint endpoint, const QString &query = QString());
+	// Request with the URL, method, timeout, priority and retry policy of the endpoint. Headers,
+	// body and cancellation are left to the caller.
+	static NetworkRequest request(ApiEndpoint endpoint, const QString &query = QString());
+	// Circuit breaker key for a platform's requests to url: the platform id, a '/', and the host.
+	// Platforms served from one host, as the API stand-ins are, still fail and recover separately.
+	static std::string circuit(const QString &platform, const QString &url);
+};
+
+#endif // APIENDPOINTS_H
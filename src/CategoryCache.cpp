@@ -0,0 +1,351 @@
+#include "CategoryCache.h"
+#include "MetricsRegistry.h"
+#include "ConfigManager.h"
+
+#include <obs-module.h>
+#include <obs-data.h>
+
+#include <algorithm>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QTimer>
+
+CategoryCache::CategoryCache(const char *fileName, const char *metricsLabel, qint64 ttlSeconds,
+			     qint64 negativeTtlSeconds)
+	: fileName(fileName),
+	  metricsLabel(metricsLabel),
+	  ttlSeconds(ttlSeconds),
+	  negativeTtlSeconds(negativeTtlSeconds)
+{
+}
+
+CategoryCache::~CategoryCache()
+{
+	flush();
+}
+
+QString CategoryCache::normalize(const QString &gameName)
+{
+	return gameName.simplified().toLower();
+}
+
+QString CategoryCache::foldForMatching(const QString &name)
+{
+	QString decomposed = name.normalized(QString::NormalizationForm_KD).toLower();
+	QString folded;
+	folded.reserve(decomposed.size());
+	for (QChar c : decomposed) {
+		if (c.isMark())
+			continue;
+		folded.append(c.isLetterOrNumber() ? c : QChar(' '));
+	}
+	return folded.simplified();
+}
+
+QList<int> CategoryCache::numberTokens(const QString &folded)
+{
+	static const QRegularExpression roman("^m{0,3}(cm|cd|d?c{0,3})(xc|xl|l?x{0,3})(ix|iv|v?i{0,3})$");
+	static const QString romanLetters = "ivxlcdm";
+	static const int romanValues[] = {1, 5, 10, 50, 100, 500, 1000};
+
+	QList<int> numbers;
+	for (const QString &token : folded.split(' ')) {
+		if (token.isEmpty())
+			continue;
+		bool isNumber = false;
+		int value = token.toInt(&isNumber);
+		if (isNumber) {
+			numbers.append(value);
+			continue;
+		}
+		if (!roman.match(token).hasMatch())
+			continue;
+
+		value = 0;
+		int previous = 0;
+		for (int i = token.size() - 1; i >= 0; --i) {
+			int digit = romanValues[romanLetters.indexOf(token[i])];
+			value += digit < previous ? -digit : digit;
+			previous = std::max(previous, digit);
+		}
+		numbers.append(value);
+	}
+	return numbers;
+}
+
+CategoryCache::KnownCategory CategoryCache::knownCategory(const QString &name)
+{
+	QString folded = foldForMatching(name);
+	return {name, folded, numberTokens(folded)};
+}
+
+double CategoryCache::similarity(const QString &a, const QString &b)
+{
+	return foldedSimilarity(foldForMatching(a), foldForMatching(b));
+}
+
+double CategoryCache::foldedSimilarity(QString left, QString right)
+{
+	if (left.isEmpty() || right.isEmpty())
+		return 0.0;
+	if (left == right)
+		return 1.0;
+
+	left.remove(' ');
+	right.remove(' ');
+	if (left == right)
+		return 0.99;
+	if (left.size() < 2 || right.size() < 2)
+		return 0.0;
+
+	// Sorensen-Dice coefficient over character bigrams.
+	QHash<QString, int> bigrams;
+	for (int i = 0; i + 1 < left.size(); ++i)
+		bigrams[left.mid(i, 2)]++;
+
+	int shared = 0;
+	for (int i = 0; i + 1 < right.size(); ++i) {
+		auto it = bigrams.find(right.mid(i, 2));
+		if (it != bigrams.end() && it.value() > 0) {
+			it.value()--;
+			shared++;
+		}
+	}
+	return (2.0 * shared) / ((left.size() - 1) + (right.size() - 1));
+}
+
+bool CategoryCache::lookup(const QString &gameName, QString *id)
+{
+	QMutexLocker locker(&mutex);
+	ensureLoaded();
+
+	const char *result = "miss";
+	bool hit = false;
+
+	auto it = entries.find(normalize(gameName));
+	if (it != entries.end()) {
+		if (it.value().expiresAt > QDateTime::currentSecsSinceEpoch()) {
+			if (id)
+				*id = it.value().id;
+			result = it.value().id.isEmpty() ? "negative" : "hit";
+			hit = true;
+		} else {
+			entries.erase(it);
+			result = "expired";
+		}
+	}
+
+	MetricsRegistry::get().incrementCounter("gamedetector_category_cache_lookups_total",
+						MetricsRegistry::labels({{"cache", metricsLabel}, {"result", result}}));
+	return hit;
+}
+
+void CategoryCache::store(const QString &gameName, const QString &id)
+{
+	QMutexLocker locker(&mutex);
+	ensureLoaded();
+
+	Entry entry;
+	entry.id = id;
+	entry.expiresAt = QDateTime::currentSecsSinceEpoch() + (id.isEmpty() ? negativeTtlSeconds : ttlSeconds);
+	entries.insert(normalize(gameName), entry);
+	scheduleSave();
+}
+
+void CategoryCache::storeBatch(const QHash<QString, QString> &ids, bool save)
+{
+	if (ids.isEmpty())
+		return;
+
+	QMutexLocker locker(&mutex);
+	ensureLoaded();
+
+	qint64 now = QDateTime::currentSecsSinceEpoch();
+	for (auto it = ids.cbegin(); it != ids.cend(); ++it) {
+		Entry entry;
+		entry.id = it.value();
+		entry.expiresAt = now + (entry.id.isEmpty() ? negativeTtlSeconds : ttlSeconds);
+		entries.insert(normalize(it.key()), entry);
+	}
+	if (save)
+		scheduleSave();
+	else
+		dirty = true;
+}
+
+bool CategoryCache::contains(const QString &gameName)
+{
+	QMutexLocker locker(&mutex);
+	ensureLoaded();
+
+	auto it = entries.constFind(normalize(gameName));
+	return it != entries.cend() && it.value().expiresAt > QDateTime::currentSecsSinceEpoch();
+}
+
+void CategoryCache::clear()
+{
+	QMutexLocker locker(&mutex);
+	ensureLoaded();
+	entries.clear();
+	catalog.clear();
+	scheduleSave();
+}
+
+void CategoryCache::rememberCategory(const QString &id, const QString &name)
+{
+	if (id.isEmpty() || name.isEmpty())
+		return;
+
+	QMutexLocker locker(&mutex);
+	ensureLoaded();
+	if (catalog.size() < MAX_CATALOG_SIZE || catalog.contains(id))
+		catalog.insert(id, knownCategory(name));
+}
+
+QString CategoryCache::findCategory(const QString &gameName, double minScore, QString *matchedName)
+{
+	QMutexLocker locker(&mutex);
+	ensureLoaded();
+
+	QString folded = foldForMatching(gameName);
+	QList<int> numbers = numberTokens(folded);
+	QString bestId;
+	double bestScore = minScore;
+	for (auto it = catalog.cbegin(); it != catalog.cend(); ++it) {
+		// Sequels and numbered editions share almost every bigram with each other.
+		if (it.value().numbers != numbers)
+			continue;
+		double score = foldedSimilarity(folded, it.value().folded);
+		if (score >= bestScore) {
+			bestScore = score;
+			bestId = it.key();
+			if (matchedName)
+				*matchedName = it.value().name;
+			if (score >= 1.0)
+				break;
+		}
+	}
+	return bestId;
+}
+
+void CategoryCache::ensureLoaded()
+{
+	// Reloads when the APIs are switched to or from a stand-in, so state learned from one is
+	// never written to the other's file.
+	QString stateFileName = ConfigManager::get().getApiStateFileName(fileName);
+	if (stateFileName == loadedFileName)
+		return;
+	entries.clear();
+	catalog.clear();
+	loadedFileName = stateFileName;
+
+	char *path = obs_module_config_path(loadedFileName.toUtf8().constData());
+	if (!path)
+		return;
+	obs_data_t *data = obs_data_create_from_json_file(path);
+	bfree(path);
+	if (!data)
+		return;
+
+	qint64 now = QDateTime::currentSecsSinceEpoch();
+	obs_data_array_t *items = obs_data_get_array(data, "entries");
+	for (size_t i = 0; i < obs_data_array_count(items); ++i) {
+		obs_data_t *item = obs_data_array_item(items, i);
+		Entry entry;
+		entry.id = QString::fromUtf8(obs_data_get_string(item, "id"));
+		entry.expiresAt = obs_data_get_int(item, "expires_at");
+		if (entry.expiresAt > now)
+			entries.insert(QString::fromUtf8(obs_data_get_string(item, "name")), entry);
+		obs_data_release(item);
+	}
+	obs_data_array_release(items);
+
+	obs_data_array_t *known = obs_data_get_array(data, "categories");
+	for (size_t i = 0; i < obs_data_array_count(known); ++i) {
+		obs_data_t *item = obs_data_array_item(known, i);
+		QString name = QString::fromUtf8(obs_data_get_string(item, "name"));
+		catalog.insert(QString::fromUtf8(obs_data_get_string(item, "id")), knownCategory(name));
+		obs_data_release(item);
+	}
+	obs_data_array_release(known);
+	obs_data_release(data);
+
+	blog(LOG_INFO, "[GameDetector/CategoryCache] Loaded %d cached and %d known %s categories.",
+	     static_cast<int>(entries.size()), static_cast<int>(catalog.size()), metricsLabel);
+}
+
+void CategoryCache::scheduleSave()
+{
+	dirty = true;
+	if (saveScheduled.exchange(true))
+		return;
+	// Stores come from the reactor and pool threads, which must not wait on the disk. The file is
+	// written on the main thread instead, once per burst of stores.
+	QMetaObject::invokeMethod(
+		&saveContext,
+		[this]() { QTimer::singleShot(SAVE_DELAY_MS, &saveContext, [this]() { flush(); }); },
+		Qt::QueuedConnection);
+}
+
+void CategoryCache::flush()
+{
+	// The maps are implicitly shared, so the copies are cheap and the lock is not held for the write.
+	QString stateFileName;
+	QHash<QString, Entry> entriesSnapshot;
+	QHash<QString, KnownCategory> catalogSnapshot;
+	{
+		QMutexLocker locker(&mutex);
+		saveScheduled = false;
+		if (!dirty || loadedFileName.isEmpty())
+			return;
+		dirty = false;
+		stateFileName = loadedFileName;
+		entriesSnapshot = entries;
+		catalogSnapshot = catalog;
+	}
+
+	char *path = obs_module_config_path(stateFileName.toUtf8().constData());
+	if (!path)
+		return;
+
+	QDir dir = QFileInfo(QString::fromUtf8(path)).dir();
+	if (!dir.exists())
+		dir.mkpath(".");
+
+	obs_data_t *data = obs_data_create();
+	obs_data_array_t *items = obs_data_array_create();
+	for (auto it = entriesSnapshot.cbegin(); it != entriesSnapshot.cend(); ++it) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "name", it.key().toUtf8().constData());
+		obs_data_set_string(item, "id", it.value().id.toUtf8().constData());
+		obs_data_set_int(item, "expires_at", it.value().expiresAt);
+		obs_data_array_push_back(items, item);
+		obs_data_release(item);
+	}
+	obs_data_set_array(data, "entries", items);
+	obs_data_array_release(items);
+
+	if (!catalogSnapshot.isEmpty()) {
+		obs_data_array_t *known = obs_data_array_create();
+		for (auto it = catalogSnapshot.cbegin(); it != catalogSnapshot.cend(); ++it) {
+			obs_data_t *item = obs_data_create();
+			obs_data_set_string(item, "id", it.key().toUtf8().constData());
+			obs_data_set_string(item, "name", it.value().name.toUtf8().constData());
+			obs_data_array_push_back(known, item);
+			obs_data_release(item);
+		}
+		obs_data_set_array(data, "categories", known);
+		obs_data_array_release(known);
+	}
+
+	if (!obs_data_save_json_safe(data, path, "tmp", "bak"))
+		blog(LOG_WARNING, "[GameDetector/CategoryCache] Failed to save category cache to: %s", path);
+
+	obs_data_release(data);
+	bfree(path);
+}
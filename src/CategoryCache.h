@@ -0,0 +1,91 @@
+#ifndef CATEGORYCACHE_H
+#define CATEGORYCACHE_H
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+// Maps game names to a platform's category ID. Entries are kept in memory and in a JSON file
+// under the module config directory, so known games resolve without an API call. A name the
+// platform does not know is cached as an empty ID for a shorter time.
+//
+// The cache can also keep a catalog of every category a search returned, which acts as a local
+// fuzzy index: findCategory() resolves close spellings of a known category without searching.
+class CategoryCache {
+public:
+	// Construct on the main thread: the file is written there.
+	CategoryCache(const char *fileName, const char *metricsLabel, qint64 ttlSeconds, qint64 negativeTtlSeconds);
+	~CategoryCache();
+
+	// Returns true on a fresh hit. id is empty when the name is cached as not found.
+	bool lookup(const QString &gameName, QString *id);
+	void store(const QString &gameName, const QString &id);
+	// Stores many names with a single write to disk. Empty IDs are cached as not found. With
+	// save false the batch is only written with the next save, so a series of batches costs one
+	// write.
+	void storeBatch(const QHash<QString, QString> &ids, bool save = true);
+	// Like lookup(), but does not count towards the cache metrics.
+	bool contains(const QString &gameName);
+	void clear();
+	// Writes pending changes now. Stores are otherwise written SAVE_DELAY_MS later on the main thread.
+	void flush();
+
+	// Adds a category seen in a search result. The catalog is written with the next store().
+	void rememberCategory(const QString &id, const QString &name);
+	// Returns the ID of the best catalog match scoring at least minScore, or an empty string.
+	// Names that differ in a number, Arabic or Roman, never match: "Resident Evil 2" is not
+	// "Resident Evil 3" however close the spelling.
+	QString findCategory(const QString &gameName, double minScore, QString *matchedName = nullptr);
+
+	static QString normalize(const QString &gameName);
+	// Similarity in [0, 1] of two names after folding case, accents and punctuation.
+	static double similarity(const QString &a, const QString &b);
+
+	static constexpr qint64 DEFAULT_TTL_SECONDS = 30 * 24 * 60 * 60;
+	static constexpr qint64 DEFAULT_NEGATIVE_TTL_SECONDS = 60 * 60;
+	static constexpr int MAX_CATALOG_SIZE = 5000;
+	static constexpr int SAVE_DELAY_MS = 2000;
+
+private:
+	struct Entry {
+		QString id;
+		qint64 expiresAt = 0;
+	};
+
+	struct KnownCategory {
+		QString name;
+		QString folded;
+		QList<int> numbers;
+	};
+
+	static QString foldForMatching(const QString &name);
+	static double foldedSimilarity(QString left, QString right);
+	// Values of the tokens of a folded name that are Arabic or Roman numerals, in order.
+	static QList<int> numberTokens(const QString &folded);
+	static KnownCategory knownCategory(const QString &name);
+	void ensureLoaded();
+	void scheduleSave();
+
+	const char *fileName;
+	const char *metricsLabel;
+	qint64 ttlSeconds;
+	qint64 negativeTtlSeconds;
+
+	QMutex mutex;
+	QHash<QString, Entry> entries;
+	QHash<QString, KnownCategory> catalog;
+	// File the entries were read from, empty until the first access.
+	QString loadedFileName;
+	bool dirty = false;
+	std::atomic<bool> saveScheduled{false};
+	// Lives on the main thread and cancels a scheduled save when the cache goes away.
+	QObject saveContext;
+};
+
+#endif // CATEGORYCACHE_H
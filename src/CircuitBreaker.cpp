@@ -0,0 +1,78 @@
+#include "CircuitBreaker.h"
+
+#include <obs-module.h>
+
+#include <algorithm>
+
+bool CircuitBreaker::allow(const std::string &key, int64_t nowMs, bool *probe)
+{
+	*probe = false;
+	auto it = circuits.find(key);
+	if (it == circuits.end())
+		return true;
+
+	Circuit &circuit = it->second;
+	if (circuit.state == State::Closed)
+		return true;
+
+	if (circuit.state == State::Open) {
+		if (nowMs < circuit.openUntilMs)
+			return false;
+		setState(key, circuit, State::HalfOpen);
+	}
+
+	if (circuit.probeInFlight)
+		return false;
+	circuit.probeInFlight = true;
+	*probe = true;
+	return true;
+}
+
+void CircuitBreaker::record(const std::string &key, Outcome outcome, bool probe, int64_t nowMs)
+{
+	Circuit &circuit = circuits[key];
+	if (probe)
+		circuit.probeInFlight = false;
+
+	switch (outcome) {
+	case Outcome::Aborted:
+		return;
+	case Outcome::Success:
+		circuit.failures = 0;
+		circuit.openMs = OPEN_MS;
+		if (circuit.state != State::Closed)
+			setState(key, circuit, State::Closed);
+		return;
+	case Outcome::Failure:
+		break;
+	}
+
+	circuit.failures++;
+	if (circuit.state == State::HalfOpen && probe) {
+		circuit.openMs = std::min(circuit.openMs * 2, MAX_OPEN_MS);
+	} else if (circuit.state != State::Closed || circuit.failures < FAILURE_THRESHOLD) {
+		return;
+	}
+
+	circuit.openUntilMs = nowMs + circuit.openMs;
+	blog(LOG_WARNING, "[GameDetector/CircuitBreaker] %s is failing; pausing requests for %lld ms.", key.c_str(),
+	     static_cast<long long>(circuit.openMs));
+	setState(key, circuit, State::Open);
+}
+
+void CircuitBreaker::setListener(Listener newListener)
+{
+	std::lock_guard<std::mutex> lock(listenerMutex);
+	listener = std::move(newListener);
+}
+
+void CircuitBreaker::setState(const std::string &key, Circuit &circuit, State state)
+{
+	circuit.state = state;
+	if (state == State::Closed)
+		blog(LOG_INFO, "[GameDetector/CircuitBreaker] %s recovered.", key.c_str());
+
+	std::lock_guard<std::mutex> lock(listenerMutex);
+	if (listener)
+		listener(key, state);
+}
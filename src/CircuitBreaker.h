@@ -0,0 +1,53 @@
+#ifndef CIRCUITBREAKER_H
+#define CIRCUITBREAKER_H
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Tracks consecutive failures (transport errors and 5xx) per circuit, which is the host unless the
+// request names one. After FAILURE_THRESHOLD of them the circuit opens and requests on it fail
+// immediately instead of waiting for another timeout. Once the open period has passed a single
+// request is let through as a probe: success closes the circuit, failure opens it again for twice
+// as long.
+//
+// allow() and record() are only called from the NetworkEngine reactor thread.
+class CircuitBreaker {
+public:
+	enum class State { Closed, Open, HalfOpen };
+	enum class Outcome { Success, Failure, Aborted };
+	using Listener = std::function<void(const std::string &key, State state)>;
+
+	// Returns false while the circuit is open or a probe is already in flight. Sets probe when
+	// the admitted request is the one that decides whether the circuit closes.
+	bool allow(const std::string &key, int64_t nowMs, bool *probe);
+	void record(const std::string &key, Outcome outcome, bool probe, int64_t nowMs);
+
+	// Called on the reactor thread whenever a circuit changes state.
+	void setListener(Listener listener);
+
+	static constexpr int FAILURE_THRESHOLD = 5;
+	static constexpr int64_t OPEN_MS = 15000;
+	static constexpr int64_t MAX_OPEN_MS = 120000;
+
+private:
+	struct Circuit {
+		State state = State::Closed;
+		int failures = 0;
+		int64_t openUntilMs = 0;
+		int64_t openMs = OPEN_MS;
+		bool probeInFlight = false;
+	};
+
+	void setState(const std::string &key, Circuit &circuit, State state);
+
+	std::map<std::string, Circuit> circuits;
+	std::mutex listenerMutex;
+	Listener listener;
+};
+
+#endif // CIRCUITBREAKER_H
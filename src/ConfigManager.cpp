@@ -1,8 +1,11 @@
 #include "ConfigManager.h"
+#include "Tracer.h"
 #include <obs-data.h>
 #include <obs-module.h>
 #include <QFileInfo>
 #include <QDir>
+#include <QHostAddress>
+#include <QUrl>
 
 ConfigManager &ConfigManager::get()
 {
@@ -34,6 +37,10 @@ void ConfigManager::load()
 		obs_data_set_int(settings, SCAN_PERIODICALLY_INTERVAL_KEY, 60);
 		obs_data_set_string(settings, TWITCH_CHANNEL_LOGIN_KEY, "");
 		obs_data_set_int(settings, ACTION_DELAY_KEY, 30);
+		obs_data_set_bool(settings, TRACE_ENABLED_KEY, false);
+		obs_data_set_bool(settings, METRICS_ENABLED_KEY, false);
+		obs_data_set_int(settings, METRICS_PORT_KEY, 30090);
+		obs_data_set_bool(settings, NETWORK_WARMUP_KEY, true);
 
 		obs_data_array_t *empty_array = obs_data_array_create();
 		obs_data_set_array(settings, MANUAL_GAMES_KEY, empty_array);
@@ -56,6 +63,14 @@ void ConfigManager::load()
 
 	blog(LOG_INFO, "[GameDetector] Settings loaded.");
 
+	for (const char *key : API_BASE_URL_KEYS) {
+		if (obs_data_has_user_value(settings, key) && apiBaseUrlOverride(key).isEmpty() &&
+		    !QString::fromUtf8(obs_data_get_string(settings, key)).trimmed().isEmpty()) {
+			blog(LOG_WARNING, "[GameDetector] Ignoring %s: only https or loopback URLs are allowed.", key);
+		}
+	}
+	updateApiRedirected();
+
 	if (!obs_data_has_user_value(settings, COMMAND_KEY))
 		obs_data_set_string(settings, COMMAND_KEY, "!setgame {game}");
 
@@ -113,6 +128,18 @@ void ConfigManager::load()
 	if (!obs_data_has_user_value(settings, ACTION_DELAY_KEY))
 		obs_data_set_int(settings, ACTION_DELAY_KEY, 30);
 
+	if (!obs_data_has_user_value(settings, TRACE_ENABLED_KEY))
+		obs_data_set_bool(settings, TRACE_ENABLED_KEY, false);
+
+	if (!obs_data_has_user_value(settings, METRICS_ENABLED_KEY))
+		obs_data_set_bool(settings, METRICS_ENABLED_KEY, false);
+
+	if (!obs_data_has_user_value(settings, METRICS_PORT_KEY))
+		obs_data_set_int(settings, METRICS_PORT_KEY, 30090);
+
+	if (!obs_data_has_user_value(settings, NETWORK_WARMUP_KEY))
+		obs_data_set_bool(settings, NETWORK_WARMUP_KEY, true);
+
 	if (!obs_data_has_user_value(settings, MANUAL_GAMES_KEY)) {
 		obs_data_array_t *empty_array = obs_data_array_create();
 		obs_data_set_array(settings, MANUAL_GAMES_KEY, empty_array);
@@ -149,6 +176,8 @@ void ConfigManager::load()
 
 void ConfigManager::save(obs_data_t *data)
 {
+	TraceSpan span("ConfigManager::save", "config");
+
 	if (!data) {
 		blog(LOG_ERROR, "[GameDetector] Attempt to save null config.");
 		return;
@@ -167,6 +196,7 @@ void ConfigManager::save(obs_data_t *data)
 	if (!dir.exists())
 		dir.mkpath(".");
 
+	updateApiRedirected();
 	if (obs_data_save_json(data, config_path_c)) {
 		blog(LOG_INFO, "[GameDetector] Config salva em: %s", config_path_c);
 		emit settingsSaved();
@@ -365,6 +395,161 @@ int ConfigManager::getActionDelay() const
 	return (int)obs_data_get_int(settings, ACTION_DELAY_KEY);
 }
 
+bool ConfigManager::getTraceEnabled() const
+{
+	if (!settings)
+		return false;
+	return obs_data_get_bool(settings, TRACE_ENABLED_KEY);
+}
+
+bool ConfigManager::getMetricsEnabled() const
+{
+	if (!settings)
+		return false;
+	return obs_data_get_bool(settings, METRICS_ENABLED_KEY);
+}
+
+int ConfigManager::getMetricsPort() const
+{
+	if (!settings)
+		return 30090;
+	return (int)obs_data_get_int(settings, METRICS_PORT_KEY);
+}
+
+bool ConfigManager::getNetworkWarmup() const
+{
+	if (!settings)
+		return true;
+	return obs_data_get_bool(settings, NETWORK_WARMUP_KEY);
+}
+
+bool ConfigManager::getMockPlatformEnabled() const
+{
+	if (!settings)
+		return false;
+	return obs_data_get_bool(settings, MOCK_PLATFORM_ENABLED_KEY);
+}
+
+int ConfigManager::getMockPlatformPort() const
+{
+	if (!settings || !obs_data_has_user_value(settings, MOCK_PLATFORM_PORT_KEY))
+		return 30091;
+	return (int)obs_data_get_int(settings, MOCK_PLATFORM_PORT_KEY);
+}
+
+int ConfigManager::getMockPlatformLatencyMs() const
+{
+	if (!settings || !obs_data_has_user_value(settings, MOCK_PLATFORM_LATENCY_KEY))
+		return 200;
+	return (int)obs_data_get_int(settings, MOCK_PLATFORM_LATENCY_KEY);
+}
+
+double ConfigManager::getMockPlatformErrorRate() const
+{
+	if (!settings)
+		return 0.0;
+	return obs_data_get_double(settings, MOCK_PLATFORM_ERROR_RATE_KEY);
+}
+
+int ConfigManager::getMockPlatformRateLimit() const
+{
+	if (!settings || !obs_data_has_user_value(settings, MOCK_PLATFORM_RATE_LIMIT_KEY))
+		return 800;
+	return (int)obs_data_get_int(settings, MOCK_PLATFORM_RATE_LIMIT_KEY);
+}
+
+double ConfigManager::getMockPlatformAuthFailureRate() const
+{
+	if (!settings)
+		return 0.0;
+	return obs_data_get_double(settings, MOCK_PLATFORM_AUTH_FAILURE_RATE_KEY);
+}
+
+bool ConfigManager::getApiStandInEnabled() const
+{
+	if (!settings)
+		return false;
+	return obs_data_get_bool(settings, API_STAND_IN_ENABLED_KEY);
+}
+
+bool ConfigManager::isAllowedApiBaseUrl(const QString &url)
+{
+	QUrl parsed(url);
+	if (!parsed.isValid() || parsed.host().isEmpty())
+		return false;
+	if (parsed.scheme() == "https")
+		return true;
+	if (parsed.scheme() != "http")
+		return false;
+	QString host = parsed.host();
+	return host == "localhost" || QHostAddress(host).isLoopback();
+}
+
+QString ConfigManager::apiBaseUrlOverride(const char *key) const
+{
+	if (!settings || !obs_data_has_user_value(settings, key))
+		return QString();
+	QString url = QString::fromUtf8(obs_data_get_string(settings, key)).trimmed();
+	while (url.endsWith("/"))
+		url.chop(1);
+	return isAllowedApiBaseUrl(url) ? url : QString();
+}
+
+QString ConfigManager::apiBaseUrl(const char *key, const char *standInPath, const char *productionUrl) const
+{
+	QString url = apiBaseUrlOverride(key);
+	if (!url.isEmpty())
+		return url;
+	if (getApiStandInEnabled())
+		return QString("http://127.0.0.1:%1%2").arg(getMockPlatformPort()).arg(standInPath);
+	return productionUrl;
+}
+
+QString ConfigManager::getTwitchAuthBaseUrl() const
+{
+	return apiBaseUrl(TWITCH_AUTH_BASE_URL_KEY, "/oauth2", "https://id.twitch.tv/oauth2");
+}
+
+QString ConfigManager::getTwitchApiBaseUrl() const
+{
+	return apiBaseUrl(TWITCH_API_BASE_URL_KEY, "/helix", "https://api.twitch.tv/helix");
+}
+
+QString ConfigManager::getTrovoAuthBaseUrl() const
+{
+	return apiBaseUrl(TROVO_AUTH_BASE_URL_KEY, "", "https://open.trovo.live");
+}
+
+QString ConfigManager::getTrovoApiBaseUrl() const
+{
+	return apiBaseUrl(TROVO_API_BASE_URL_KEY, "/openplatform", "https://open-api.trovo.live/openplatform");
+}
+
+QString ConfigManager::getTrovoRelayUrl() const
+{
+	return apiBaseUrl(TROVO_RELAY_URL_KEY, "/trovo", "https://trovo-obs.areaz12server.net.br");
+}
+
+void ConfigManager::updateApiRedirected()
+{
+	bool redirected = getApiStandInEnabled();
+	for (const char *key : API_BASE_URL_KEYS) {
+		if (!apiBaseUrlOverride(key).isEmpty())
+			redirected = true;
+	}
+	apiRedirected = redirected;
+}
+
+bool ConfigManager::isApiRedirected() const
+{
+	return apiRedirected.load();
+}
+
+QString ConfigManager::getApiStateFileName(const char *fileName) const
+{
+	return isApiRedirected() ? QString("standin_") + fileName : QString::fromUtf8(fileName);
+}
+
 void ConfigManager::setTwitchToken(const QString &value)
 {
 	if (!settings)
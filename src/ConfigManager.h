@@ -5,6 +5,8 @@
 #include <QObject>
 #include <QString>
 
+#include <atomic>
+
 class ConfigManager : public QObject {
 	Q_OBJECT
 
@@ -26,6 +28,15 @@ private:
 	obs_data_t *settings = nullptr;
 
 	explicit ConfigManager(QObject *parent = nullptr);
+	QString apiBaseUrl(const char *key, const char *standInPath, const char *productionUrl) const;
+	// The *_base_url value of key, or an empty string when it is unset or not allowed.
+	QString apiBaseUrlOverride(const char *key) const;
+	// Requests carry OAuth tokens, so an override must use https or stay on this machine.
+	static bool isAllowedApiBaseUrl(const QString &url);
+	// Recomputed on the main thread whenever the settings are loaded or saved, so caches on other
+	// threads can ask for their file name without reading obs_data.
+	void updateApiRedirected();
+	std::atomic<bool> apiRedirected{false};
 
 public:
 	static constexpr const char *HOTKEY_SET_GAME_KEY = "hotkey_set_game";
@@ -62,6 +73,33 @@ public:
 	bool getScanOnStartup() const;
 	bool getScanPeriodically() const;
 	int getScanPeriodicallyInterval() const;
+	bool getTraceEnabled() const;
+	bool getMetricsEnabled() const;
+	int getMetricsPort() const;
+	bool getNetworkWarmup() const;
+	// Local stand-in platform for load testing. Not exposed in the settings dialog.
+	bool getMockPlatformEnabled() const;
+	int getMockPlatformPort() const;
+	int getMockPlatformLatencyMs() const;
+	double getMockPlatformErrorRate() const;
+	int getMockPlatformRateLimit() const;
+	double getMockPlatformAuthFailureRate() const;
+	// Sends every platform call to MockPlatformServer instead of the real APIs.
+	bool getApiStandInEnabled() const;
+	// API base URLs, without a trailing slash. A *_base_url key in the config wins, then the
+	// stand-in when it is enabled, then the production URL. Overrides that are neither https nor
+	// loopback are ignored.
+	QString getTwitchAuthBaseUrl() const;
+	QString getTwitchApiBaseUrl() const;
+	QString getTrovoAuthBaseUrl() const;
+	QString getTrovoApiBaseUrl() const;
+	QString getTrovoRelayUrl() const;
+	// True while the stand-in or a *_base_url override serves any platform API.
+	bool isApiRedirected() const;
+	// File under the module config directory for state learned from the platform APIs, such as
+	// cached category IDs. While the APIs are redirected it gets a "standin_" prefix, so IDs made
+	// up by a stand-in never end up in the production files.
+	QString getApiStateFileName(const char *fileName) const;
 
 	void setTwitchToken(const QString &value);
 	void setTwitchRefreshToken(const QString &value);
@@ -81,6 +119,25 @@ public:
 	static constexpr const char *SCAN_PERIODICALLY_KEY = "scan_periodically";
 	static constexpr const char *SCAN_PERIODICALLY_INTERVAL_KEY = "scan_periodically_interval";
 	static constexpr const char *ACTION_DELAY_KEY = "twitch_action_delay";
+	static constexpr const char *TRACE_ENABLED_KEY = "trace_enabled";
+	static constexpr const char *METRICS_ENABLED_KEY = "metrics_enabled";
+	static constexpr const char *METRICS_PORT_KEY = "metrics_port";
+	static constexpr const char *NETWORK_WARMUP_KEY = "network_warmup";
+	static constexpr const char *MOCK_PLATFORM_ENABLED_KEY = "mock_platform_enabled";
+	static constexpr const char *MOCK_PLATFORM_PORT_KEY = "mock_platform_port";
+	static constexpr const char *MOCK_PLATFORM_LATENCY_KEY = "mock_platform_latency_ms";
+	static constexpr const char *MOCK_PLATFORM_ERROR_RATE_KEY = "mock_platform_error_rate";
+	static constexpr const char *MOCK_PLATFORM_RATE_LIMIT_KEY = "mock_platform_rate_limit";
+	static constexpr const char *MOCK_PLATFORM_AUTH_FAILURE_RATE_KEY = "mock_platform_auth_failure_rate";
+	static constexpr const char *API_STAND_IN_ENABLED_KEY = "api_stand_in_enabled";
+	static constexpr const char *TWITCH_AUTH_BASE_URL_KEY = "twitch_auth_base_url";
+	static constexpr const char *TWITCH_API_BASE_URL_KEY = "twitch_api_base_url";
+	static constexpr const char *TROVO_AUTH_BASE_URL_KEY = "trovo_auth_base_url";
+	static constexpr const char *TROVO_API_BASE_URL_KEY = "trovo_api_base_url";
+	static constexpr const char *TROVO_RELAY_URL_KEY = "trovo_relay_url";
+	static constexpr const char *API_BASE_URL_KEYS[] = {TWITCH_AUTH_BASE_URL_KEY, TWITCH_API_BASE_URL_KEY,
+							    TROVO_AUTH_BASE_URL_KEY, TROVO_API_BASE_URL_KEY,
+							    TROVO_RELAY_URL_KEY};
 
 signals:
 	void settingsSaved();
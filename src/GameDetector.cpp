@@ -1,6 +1,8 @@
 #include "GameDetector.h"
 #include <obs-module.h>
 #include "ConfigManager.h"
+#include "Tracer.h"
+#include "MetricsRegistry.h"
 #include <QFileInfo>
 #include <QRegularExpression>
 #include <QDirIterator>
@@ -74,6 +76,7 @@ void GameDetector::rescanForGames(bool scanSteam, bool scanEpic, bool scanGog, b
 	this->tempScanUbisoft = scanUbisoft;
 
 	abortScan = false;
+	scanElapsed.start();
 	blog(LOG_INFO, "[GameDetector] Starting background game scan...");
 	QFuture<QList<std::tuple<QString, QString, QString>>> future =
 		QtConcurrent::run([this]() { return populateGameExecutables(); });
@@ -84,7 +87,11 @@ void GameDetector::onGameScanFinished()
 {
 	blog(LOG_INFO, "[GameDetector] Game scan completed. Starting process monitoring.");
 
-	emit automaticScanFinished(gameDbWatcher->result());
+	auto foundGames = gameDbWatcher->result();
+	MetricsRegistry::get().observe("gamedetector_scan_duration_seconds", scanElapsed.nsecsElapsed() / 1e9);
+	MetricsRegistry::get().setGauge("gamedetector_scan_games_found", foundGames.size());
+
+	emit automaticScanFinished(foundGames);
 }
 
 void GameDetector::onSettingsChanged()
@@ -297,6 +304,7 @@ const QSet<QString> ignoreFullNames = {"7za.exe",
 
 QList<std::tuple<QString, QString, QString>> GameDetector::populateGameExecutables()
 {
+	TraceSpan span("GameDetector::populateGameExecutables", "scan");
 	QList<std::tuple<QString, QString, QString>> foundGames;
 
 #ifdef _WIN32
@@ -697,6 +705,7 @@ void GameDetector::loadGamesFromConfig()
 {
 	knownGameExes.clear();
 	gameNameMap.clear();
+	QStringList gameNames;
 
 	obs_data_array_t *manualGames = ConfigManager::get().getManualGames();
 	if (manualGames) {
@@ -710,15 +719,21 @@ void GameDetector::loadGamesFromConfig()
 				QString gameName = obs_data_get_string(item, "name");
 				knownGameExes.insert(exeName);
 				gameNameMap.insert(exeName, gameName);
+				gameNames.append(gameName);
 			}
 			obs_data_release(item);
 		}
 		obs_data_array_release(manualGames);
 	}
+
+	emit gameListLoaded(gameNames);
 }
 
 void GameDetector::scanProcesses()
 {
+	TraceSpan span("GameDetector::scanProcesses", "detect");
+	ScopedMetricsTimer tickTimer("gamedetector_detection_tick_duration_seconds");
+	MetricsRegistry::get().incrementCounter("gamedetector_detection_ticks_total");
 #ifdef _WIN32
 	DWORD processes[1024], bytesReturned;
 	if (!EnumProcesses(processes, sizeof(processes), &bytesReturned)) {
@@ -4,10 +4,12 @@
 #include <QObject>
 #include <QTimer>
 #include <QString>
+#include <QStringList>
 #include <QSet>
 #include <QHash>
 #include <tuple>
 #include <QFutureWatcher>
+#include <QElapsedTimer>
 #include <atomic>
 
 class GameDetector : public QObject {
@@ -17,6 +19,7 @@ private:
 	QTimer *scanTimer;
 	QTimer *periodicScanTimer;
 	QFutureWatcher<QList<std::tuple<QString, QString, QString>>> *gameDbWatcher;
+	QElapsedTimer scanElapsed;
 	QString currentGameProcess;
 	QHash<QString, QString> gameNameMap; // exe -> friendly name
 	QSet<QString> knownGameExes;
@@ -56,6 +59,7 @@ signals:
 	void noGameDetected();
 	void automaticScanFinished(const QList<std::tuple<QString, QString, QString>> &foundGames);
 	void gameFoundDuringScan(int totalFound);
+	void gameListLoaded(const QStringList &gameNames);
 
 private slots:
 	void scanProcesses();
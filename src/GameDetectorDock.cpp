@@ -111,9 +111,6 @@ GameDetectorDock::GameDetectorDock(QWidget *parent) : QWidget(parent)
 
 	connect(executeCommandButton, &QPushButton::clicked, this, &GameDetectorDock::onExecuteCommandClicked);
 	connect(manualGameButton, &QPushButton::clicked, this, [this]() {
-		if (PlatformManager::get().isOnCooldown())
-			return;
-
 		QDialog dialog(this);
 		dialog.setWindowTitle(obs_module_text("Dock.ManualGame.Title"));
 		dialog.setMinimumWidth(300);
@@ -183,10 +180,6 @@ GameDetectorDock::GameDetectorDock(QWidget *parent) : QWidget(parent)
 			if ((twitchCheck || trovoCheck) && platforms.isEmpty())
 				return;
 
-			if (!platforms.isEmpty()) {
-				PlatformManager::get().setProperty("targetPlatforms", platforms);
-			}
-
 			buttonBox->button(QDialogButtonBox::Ok)->setEnabled(false);
 			input->setEnabled(false);
 			if (twitchCheck)
@@ -224,15 +217,28 @@ GameDetectorDock::GameDetectorDock(QWidget *parent) : QWidget(parent)
 					}
 				});
 
-			if (!PlatformManager::get().updateCategory(gameName, title, true)) {
+			const char *message = nullptr;
+			switch (PlatformManager::get().updateCategory(gameName, title, true, platforms)) {
+			case PlatformManager::UpdateResult::Sent:
+				return;
+			case PlatformManager::UpdateResult::Queued:
+				// The dialog closes once the queued update goes through.
 				statusLabel->setText(obs_module_text("Dock.ManualGame.Cooldown"));
-				buttonBox->button(QDialogButtonBox::Ok)->setEnabled(true);
-				input->setEnabled(true);
-				if (twitchCheck)
-					twitchCheck->setEnabled(true);
-				if (trovoCheck)
-					trovoCheck->setEnabled(true);
+				return;
+			case PlatformManager::UpdateResult::UpToDate:
+				message = "Dock.ManualGame.AlreadySet";
+				break;
+			case PlatformManager::UpdateResult::Unavailable:
+				message = "Dock.ManualGame.NoPlatform";
+				break;
 			}
+			statusLabel->setText(obs_module_text(message));
+			buttonBox->button(QDialogButtonBox::Ok)->setEnabled(true);
+			input->setEnabled(true);
+			if (twitchCheck)
+				twitchCheck->setEnabled(true);
+			if (trovoCheck)
+				trovoCheck->setEnabled(true);
 		});
 		connect(buttonBox, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
 		dialog.exec();
@@ -248,9 +254,14 @@ GameDetectorDock::GameDetectorDock(QWidget *parent) : QWidget(parent)
 	connect(&PlatformManager::get(), &PlatformManager::categoriesFetched, this,
 		&GameDetectorDock::onCategoriesFetched);
 
+	connect(&PlatformManager::get(), &PlatformManager::platformHealthChanged, this,
+		&GameDetectorDock::onPlatformHealthChanged);
+
 	connect(&PlatformManager::get(), &PlatformManager::cooldownStarted, this, &GameDetectorDock::onCooldownStarted);
 	connect(&PlatformManager::get(), &PlatformManager::cooldownFinished, this,
 		&GameDetectorDock::onCooldownFinished);
+	connect(&PlatformManager::get(), &PlatformManager::pendingUpdateChanged, this,
+		&GameDetectorDock::onPendingUpdateChanged);
 
 	connect(autoExecuteCheckbox, &QCheckBox::checkStateChanged, this, &GameDetectorDock::onSettingsChanged);
 
@@ -308,18 +319,12 @@ void GameDetectorDock::onNoGameDetected()
 
 void GameDetectorDock::onExecuteCommandClicked()
 {
-	if (PlatformManager::get().isOnCooldown()) {
-		return;
-	}
 	this->desiredCategory = detectedGameName;
 	PlatformManager::get().updateCategory(desiredCategory);
 }
 
 void GameDetectorDock::onSetJustChattingClicked()
 {
-	if (PlatformManager::get().isOnCooldown()) {
-		return;
-	}
 	this->desiredCategory = "Just Chatting";
 	PlatformManager::get().updateCategory(desiredCategory, QString(), true);
 }
@@ -379,7 +384,7 @@ void GameDetectorDock::onCategoriesFetched(const QHash<QString, QString> &catego
 		} else {
 			twitchTitleLabel->setText(QString(obs_module_text("Dock.Platform.Title")).arg(title));
 			// set platform label text
-			twitchPlatformLabel->setText(obs_module_text("Dock.PlatformName.Twitch"));
+			twitchPlatformLabel->setText(platformLabelText("Twitch"));
 			twitchTitleLabel->setVisible(true);
 		}
 	}
@@ -403,7 +408,7 @@ void GameDetectorDock::onCategoriesFetched(const QHash<QString, QString> &catego
 		} else {
 			trovoTitleLabel->setText(QString(obs_module_text("Dock.Platform.Title")).arg(title));
 			// set platform label text
-			trovoPlatformLabel->setText(obs_module_text("Dock.PlatformName.Trovo"));
+			trovoPlatformLabel->setText(platformLabelText("Trovo"));
 			trovoTitleLabel->setVisible(true);
 		}
 		// store last known title for prefill
@@ -411,6 +416,35 @@ void GameDetectorDock::onCategoriesFetched(const QHash<QString, QString> &catego
 	}
 }
 
+QString GameDetectorDock::platformLabelText(const QString &platform) const
+{
+	QString text = obs_module_text(("Dock.PlatformName." + platform).toUtf8().constData());
+	switch (platformHealth.value(platform, CircuitBreaker::State::Closed)) {
+	case CircuitBreaker::State::Open:
+		text += " " + QString(obs_module_text("Dock.Platform.Unavailable"));
+		break;
+	case CircuitBreaker::State::HalfOpen:
+		text += " " + QString(obs_module_text("Dock.Platform.Recovering"));
+		break;
+	default:
+		break;
+	}
+	return text;
+}
+
+void GameDetectorDock::onPlatformHealthChanged(const QString &platform, CircuitBreaker::State state)
+{
+	platformHealth[platform] = state;
+
+	QLabel *label = nullptr;
+	if (platform == "Twitch")
+		label = twitchPlatformLabel;
+	else if (platform == "Trovo")
+		label = trovoPlatformLabel;
+	if (label && label->isVisible())
+		label->setText(platformLabelText(platform));
+}
+
 void GameDetectorDock::checkWarningsAndStatus()
 {
 	updateAutoExecuteCheckboxText();
@@ -434,7 +468,13 @@ void GameDetectorDock::checkWarningsAndStatus()
 		return;
 	}
 
+	bool onlyWhileStreaming = ConfigManager::get().getBlockAutoUpdateWhileStreaming();
+	bool shouldAutoUpdateNow = !onlyWhileStreaming || obs_frontend_streaming_active();
+
 	if (PlatformManager::get().isOnCooldown()) {
+		// Queued by the platform manager; the latest detection is applied when the cooldown ends.
+		if (autoExecuteCheckbox->isChecked() && shouldAutoUpdateNow)
+			PlatformManager::get().updateCategory(desiredCategory);
 		if (!cooldownUpdateTimer->isActive()) {
 			int remaining = PlatformManager::get().getCooldownRemaining();
 			if (remaining > 0)
@@ -443,8 +483,6 @@ void GameDetectorDock::checkWarningsAndStatus()
 		return;
 	}
 
-	bool onlyWhileStreaming = ConfigManager::get().getBlockAutoUpdateWhileStreaming();
-	bool shouldAutoUpdateNow = !onlyWhileStreaming || obs_frontend_streaming_active();
 	if (autoExecuteCheckbox->isChecked() && shouldAutoUpdateNow) {
 		PlatformManager::get().updateCategory(desiredCategory);
 	}
@@ -458,7 +496,7 @@ void GameDetectorDock::checkWarningsAndStatus()
 	if (twitchConnected) {
 		twitchPlatformLabel->setVisible(true);
 		if (twitchPlatformLabel->text().isEmpty())
-			twitchPlatformLabel->setText(obs_module_text("Dock.PlatformName.Twitch"));
+			twitchPlatformLabel->setText(platformLabelText("Twitch"));
 		twitchStatusLabel->setVisible(true);
 		if (twitchStatusLabel->text().isEmpty()) {
 			twitchStatusLabel->setText(obs_module_text("Status.Fetching"));
@@ -473,7 +511,7 @@ void GameDetectorDock::checkWarningsAndStatus()
 	if (trovoConnected) {
 		trovoPlatformLabel->setVisible(true);
 		if (trovoPlatformLabel->text().isEmpty())
-			trovoPlatformLabel->setText(obs_module_text("Dock.PlatformName.Trovo"));
+			trovoPlatformLabel->setText(platformLabelText("Trovo"));
 		trovoStatusLabel->setVisible(true);
 		if (trovoStatusLabel->text().isEmpty()) {
 			trovoStatusLabel->setText(obs_module_text("Status.Fetching"));
@@ -534,13 +572,7 @@ void GameDetectorDock::onAuthenticationRequired()
 
 void GameDetectorDock::onCooldownStarted(int seconds)
 {
-	GameDetector::get().stopScanning();
-	if (executeCommandButton)
-		executeCommandButton->setEnabled(false);
-	if (setJustChattingButton)
-		setJustChattingButton->setEnabled(false);
-	if (manualGameButton)
-		manualGameButton->setEnabled(false);
+	// Buttons stay enabled: a platform that is still cooling down queues the request.
 	cooldownUpdateTimer->setProperty("remaining", seconds);
 	updateCooldownLabel();
 	cooldownUpdateTimer->start(1000);
@@ -549,13 +581,6 @@ void GameDetectorDock::onCooldownStarted(int seconds)
 void GameDetectorDock::onCooldownFinished()
 {
 	cooldownUpdateTimer->stop();
-	GameDetector::get().startScanning();
-	if (executeCommandButton)
-		executeCommandButton->setEnabled(true);
-	if (setJustChattingButton)
-		setJustChattingButton->setEnabled(true);
-	if (manualGameButton)
-		manualGameButton->setEnabled(true);
 	checkWarningsAndStatus();
 }
 
@@ -563,15 +588,34 @@ void GameDetectorDock::updateCooldownLabel()
 {
 	int remaining = cooldownUpdateTimer->property("remaining").toInt();
 	if (remaining >= 0) {
-		QString timeStr = QTime(0, 0).addSecs(remaining).toString("mm:ss");
-		QString currentGameText = QString(obs_module_text("Status.Playing")).arg(desiredCategory);
-		statusLabel->setText(QString(obs_module_text("Dock.OnCooldown")).arg(currentGameText).arg(timeStr));
+		statusLabel->setText(cooldownLabelText(remaining));
 		cooldownUpdateTimer->setProperty("remaining", remaining - 1);
 	} else {
 		onCooldownFinished();
 	}
 }
 
+QString GameDetectorDock::cooldownLabelText(int remaining) const
+{
+	QString timeStr = QTime(0, 0).addSecs(remaining).toString("mm:ss");
+	QString currentGameText = QString(obs_module_text("Status.Playing")).arg(desiredCategory);
+	if (!pendingCategory.isEmpty()) {
+		return QString(obs_module_text("Dock.OnCooldown.Pending"))
+			.arg(currentGameText)
+			.arg(timeStr)
+			.arg(pendingCategory);
+	}
+	return QString(obs_module_text("Dock.OnCooldown")).arg(currentGameText).arg(timeStr);
+}
+
+void GameDetectorDock::onPendingUpdateChanged(const QString &gameName)
+{
+	pendingCategory = gameName;
+	// The label shows the value from before the last decrement.
+	if (cooldownUpdateTimer->isActive())
+		statusLabel->setText(cooldownLabelText(cooldownUpdateTimer->property("remaining").toInt() + 1));
+}
+
 GameDetectorDock::~GameDetectorDock()
 {
 	if (cooldownUpdateTimer->isActive())
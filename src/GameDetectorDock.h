@@ -9,8 +9,11 @@
 #include <QTableWidget>
 #include <QComboBox>
 #include <QCheckBox>
+#include <QHash>
 #include <obs-module.h>
 
+#include "CircuitBreaker.h"
+
 class GameDetectorSettingsDialog;
 
 class GameDetectorDock : public QWidget {
@@ -38,12 +41,18 @@ private:
 	QString desiredTitle = QString();
 	QString lastTwitchTitle = QString();
 	QString lastTrovoTitle = QString();
+	QHash<QString, CircuitBreaker::State> platformHealth;
+	QString pendingCategory;
 
 	void restoreStatusLabel();
 	void updateAutoExecuteCheckboxText();
 	void onCooldownStarted(int seconds);
 	void onCooldownFinished();
 	void updateCooldownLabel();
+	QString cooldownLabelText(int remaining) const;
+	void onPendingUpdateChanged(const QString &gameName);
+	QString platformLabelText(const QString &platform) const;
+	void onPlatformHealthChanged(const QString &platform, CircuitBreaker::State state);
 
 	QTimer *saveDelayTimer = nullptr;
 	QTimer *statusCheckTimer = nullptr;
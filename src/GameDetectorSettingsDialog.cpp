@@ -6,6 +6,8 @@
 #include "TwitchAuthManager.h"
 #include "TrovoAuthManager.h"
 #include "PlatformManager.h"
+#include "Tracer.h"
+#include "MetricsServer.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -19,6 +21,7 @@
 #include <QSpinBox>
 #include <QLineEdit>
 #include <QCheckBox>
+#include <QFileDialog>
 #include <obs.h>
 #include <obs-module.h>
 #include <obs-data.h>
@@ -159,6 +162,23 @@ GameDetectorSettingsDialog::GameDetectorSettingsDialog(QWidget *parent) : QDialo
 
 	mainLayout->addLayout(authAndActionLayout);
 
+	QGroupBox *diagnosticsGroup = new QGroupBox(obs_module_text("Settings.Diagnostics"));
+	QHBoxLayout *diagnosticsLayout = new QHBoxLayout();
+	traceEnabledCheckbox = new QCheckBox(obs_module_text("Settings.TraceEnabled"));
+	diagnosticsLayout->addWidget(traceEnabledCheckbox);
+	exportTraceButton = new QPushButton(obs_module_text("Settings.ExportTrace"));
+	diagnosticsLayout->addWidget(exportTraceButton);
+	diagnosticsLayout->addSpacing(20);
+	metricsEnabledCheckbox = new QCheckBox(obs_module_text("Settings.MetricsEnabled"));
+	metricsEnabledCheckbox->setToolTip(obs_module_text("Settings.MetricsEnabled.Tooltip"));
+	diagnosticsLayout->addWidget(metricsEnabledCheckbox);
+	metricsPortSpinbox = new QSpinBox();
+	metricsPortSpinbox->setRange(1024, 65535);
+	diagnosticsLayout->addWidget(metricsPortSpinbox);
+	diagnosticsLayout->addStretch(1);
+	diagnosticsGroup->setLayout(diagnosticsLayout);
+	mainLayout->addWidget(diagnosticsGroup);
+
 	mainLayout->addStretch(1);
 
 	QHBoxLayout *dialogButtonsLayout = new QHBoxLayout();
@@ -174,6 +194,7 @@ GameDetectorSettingsDialog::GameDetectorSettingsDialog(QWidget *parent) : QDialo
 	mainLayout->addLayout(dialogButtonsLayout);
 
 	connect(manageGamesButton, &QPushButton::clicked, this, &GameDetectorSettingsDialog::onManageGamesClicked);
+	connect(exportTraceButton, &QPushButton::clicked, this, &GameDetectorSettingsDialog::onExportTraceClicked);
 	connect(authButton, &QPushButton::clicked, this, [this]() {
 		TwitchAuthManager::get().startAuthentication(actionComboBox->currentIndex(),
 							     unifiedAuthCheckbox->isChecked() ? 1 : 0);
@@ -219,6 +240,9 @@ GameDetectorSettingsDialog::GameDetectorSettingsDialog(QWidget *parent) : QDialo
 
 	connect(scanPeriodicallyCheckbox, &QCheckBox::checkStateChanged, this,
 		[this](int state) { scanIntervalSpinbox->setEnabled(state == Qt::Checked); });
+	connect(metricsEnabledCheckbox, &QCheckBox::checkStateChanged, this,
+		[this](int state) { metricsPortSpinbox->setEnabled(state == Qt::Checked); });
+	metricsPortSpinbox->setEnabled(metricsEnabledCheckbox->isChecked());
 }
 
 void GameDetectorSettingsDialog::loadSettings()
@@ -257,6 +281,9 @@ void GameDetectorSettingsDialog::loadSettings()
 	scanOnStartupCheckbox->setChecked(ConfigManager::get().getScanOnStartup());
 	scanPeriodicallyCheckbox->setChecked(ConfigManager::get().getScanPeriodically());
 	scanIntervalSpinbox->setValue(ConfigManager::get().getScanPeriodicallyInterval());
+	traceEnabledCheckbox->setChecked(ConfigManager::get().getTraceEnabled());
+	metricsEnabledCheckbox->setChecked(ConfigManager::get().getMetricsEnabled());
+	metricsPortSpinbox->setValue(ConfigManager::get().getMetricsPort());
 }
 
 void GameDetectorSettingsDialog::saveSettings()
@@ -278,9 +305,16 @@ void GameDetectorSettingsDialog::saveSettings()
 	obs_data_set_bool(settings, ConfigManager::SCAN_ON_STARTUP_KEY, scanOnStartupCheckbox->isChecked());
 	obs_data_set_bool(settings, ConfigManager::SCAN_PERIODICALLY_KEY, scanPeriodicallyCheckbox->isChecked());
 	obs_data_set_int(settings, ConfigManager::SCAN_PERIODICALLY_INTERVAL_KEY, scanIntervalSpinbox->value());
+	obs_data_set_bool(settings, ConfigManager::TRACE_ENABLED_KEY, traceEnabledCheckbox->isChecked());
+	obs_data_set_bool(settings, ConfigManager::METRICS_ENABLED_KEY, metricsEnabledCheckbox->isChecked());
+	obs_data_set_int(settings, ConfigManager::METRICS_PORT_KEY, metricsPortSpinbox->value());
 
 	ConfigManager::get().save(settings);
 
+	if (Tracer::get().isEnabled() != traceEnabledCheckbox->isChecked())
+		Tracer::get().setEnabled(traceEnabledCheckbox->isChecked());
+	MetricsServer::get().applySettings();
+
 	GameDetector::get().onSettingsChanged();
 	GameDetector::get().setupPeriodicScan();
 }
@@ -376,3 +410,17 @@ void GameDetectorSettingsDialog::onManageGamesClicked()
 	GameListDialog dialog(this);
 	dialog.exec();
 }
+
+void GameDetectorSettingsDialog::onExportTraceClicked()
+{
+	char *configPath = obs_module_config_path("trace.json");
+	QString defaultPath = QString::fromUtf8(configPath);
+	bfree(configPath);
+
+	QString filePath = QFileDialog::getSaveFileName(this, obs_module_text("Settings.ExportTrace.Title"),
+							defaultPath, obs_module_text("Settings.ExportTrace.Filter"));
+	if (filePath.isEmpty())
+		return;
+
+	Tracer::get().exportChromeTrace(filePath);
+}
@@ -47,6 +47,10 @@ private:
 	QCheckBox *scanOnStartupCheckbox = nullptr;
 	QCheckBox *scanPeriodicallyCheckbox = nullptr;
 	QSpinBox *scanIntervalSpinbox = nullptr;
+	QCheckBox *traceEnabledCheckbox = nullptr;
+	QPushButton *exportTraceButton = nullptr;
+	QCheckBox *metricsEnabledCheckbox = nullptr;
+	QSpinBox *metricsPortSpinbox = nullptr;
 
 private slots:
 	void onAuthenticationFinished(bool success, const QString &username);
@@ -54,6 +58,7 @@ private slots:
 	void onDisconnectClicked();
 	void onTrovoDisconnectClicked();
 	void onManageGamesClicked();
+	void onExportTraceClicked();
 };
 
 #endif // GAMEDETECTORSETTINGSDIALOG_H
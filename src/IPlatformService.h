@@ -1,16 +1,43 @@
 #pragma once
 #include <QObject>
 #include <QString>
+#include <QFuture>
+
+// Category and title read from a single channel info response. On failure valid is false,
+// category holds the error text shown in the dock and title is empty.
+struct ChannelState {
+	QString category;
+	QString title;
+	bool valid = false;
+};
 
 class IPlatformService : public QObject {
 	Q_OBJECT
 public:
+	enum Capability {
+		UpdateCategory = 0x1,
+		UpdateTitle = 0x2,
+		SendChat = 0x4,
+		ReadChannelState = 0x8,
+	};
+
 	using QObject::QObject;
 	virtual ~IPlatformService() = default;
 
+	// Stable name used as the registry key, in metrics and in the dock, such as "Twitch".
+	virtual QString platformId() const = 0;
+	// Bitwise OR of Capability values.
+	virtual int capabilities() const = 0;
+
 	virtual void updateCategory(const QString &gameName, const QString &title = QString()) = 0;
 	virtual void sendChatMessage(const QString &message) = 0;
 	virtual bool isAuthenticated() const = 0;
+	virtual QFuture<ChannelState> getChannelState() = 0;
+	// Cancels the requests the service still has in flight. Called when the plugin unloads,
+	// before NetworkEngine stops.
+	virtual void shutdown() {}
+
+	bool hasCapability(Capability capability) const { return (capabilities() & capability) != 0; }
 
 signals:
 	void categoryUpdateFinished(bool success, QString gameName, QString errorMsg);
@@ -0,0 +1,173 @@
+#include "MetricsRegistry.h"
+
+#include <QMutexLocker>
+#include <QStringList>
+#include <QTextStream>
+
+#include <cmath>
+
+namespace {
+
+const double HISTOGRAM_BUCKETS[] = {0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0, 60.0};
+const int HISTOGRAM_BUCKET_COUNT = sizeof(HISTOGRAM_BUCKETS) / sizeof(HISTOGRAM_BUCKETS[0]);
+
+struct MetricHelp {
+	const char *name;
+	const char *help;
+};
+
+const MetricHelp METRIC_HELP[] = {
+	{"gamedetector_scan_duration_seconds", "Duration of installed game library scans."},
+	{"gamedetector_scan_games_found", "Number of games found by the last library scan."},
+	{"gamedetector_detection_ticks_total", "Number of process detection ticks."},
+	{"gamedetector_detection_tick_duration_seconds", "Duration of a process detection tick."},
+	{"gamedetector_http_requests_total", "HTTP requests issued to platform APIs."},
+	{"gamedetector_http_request_duration_seconds", "Latency of HTTP requests to platform APIs."},
+	{"gamedetector_http_coalesced_requests_total", "Requests merged into an identical in-flight request."},
+	{"gamedetector_http_inflight_requests", "HTTP requests currently running on the network engine."},
+	{"gamedetector_http_request_templates_built_total", "Prebuilt header sets created for a new access token."},
+	{"gamedetector_http_response_bytes_total", "Response body bytes received on the wire, by protocol."},
+	{"gamedetector_http_compression_saved_bytes_total", "Response bytes not transferred thanks to compression."},
+	{"gamedetector_http_keepalive_requests_total", "HEAD requests sent to keep warm platform connections open."},
+	{"gamedetector_http_retries_total", "Failed idempotent requests scheduled for another attempt."},
+	{"gamedetector_http_throttled_requests_total", "Requests delayed or shed to stay within platform rate limits."},
+	{"gamedetector_update_replays_total", "Unconfirmed category updates checked against the live channel state."},
+	{"gamedetector_cooldown_coalesced_total", "Actions queued during a cooldown, replacing any earlier queued one."},
+	{"gamedetector_token_refreshes_total", "Access token refresh attempts."},
+	{"gamedetector_category_cache_lookups_total", "Game name to category ID cache lookups."},
+};
+
+const char *helpFor(const QString &name)
+{
+	for (const MetricHelp &entry : METRIC_HELP) {
+		if (name == QLatin1String(entry.name))
+			return entry.help;
+	}
+	return nullptr;
+}
+
+const char *typeName(MetricsRegistry::Type type)
+{
+	switch (type) {
+	case MetricsRegistry::Type::Counter:
+		return "counter";
+	case MetricsRegistry::Type::Gauge:
+		return "gauge";
+	case MetricsRegistry::Type::Histogram:
+		return "histogram";
+	}
+	return "untyped";
+}
+
+QString formatValue(double value)
+{
+	if (std::isinf(value))
+		return value > 0 ? "+Inf" : "-Inf";
+	return QString::number(value, 'g', 12);
+}
+
+QString joinLabels(const QString &labels, const QString &extra)
+{
+	if (labels.isEmpty())
+		return "{" + extra + "}";
+	return "{" + labels + "," + extra + "}";
+}
+
+} // namespace
+
+MetricsRegistry &MetricsRegistry::get()
+{
+	static MetricsRegistry instance;
+	return instance;
+}
+
+QString MetricsRegistry::labels(std::initializer_list<std::pair<const char *, QString>> pairs)
+{
+	QStringList parts;
+	for (const auto &pair : pairs) {
+		QString value = pair.second;
+		value.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+		parts << QString("%1=\"%2\"").arg(QLatin1String(pair.first), value);
+	}
+	return parts.join(",");
+}
+
+MetricsRegistry::Family &MetricsRegistry::family(const char *name, Type type)
+{
+	auto it = families.find(QLatin1String(name));
+	if (it == families.end()) {
+		Family created;
+		created.type = type;
+		it = families.insert(QLatin1String(name), created);
+	}
+	return it.value();
+}
+
+void MetricsRegistry::incrementCounter(const char *name, const QString &labels, double value)
+{
+	QMutexLocker locker(&mutex);
+	family(name, Type::Counter).series[labels].value += value;
+}
+
+void MetricsRegistry::setGauge(const char *name, double value, const QString &labels)
+{
+	QMutexLocker locker(&mutex);
+	family(name, Type::Gauge).series[labels].value = value;
+}
+
+void MetricsRegistry::observe(const char *name, double value, const QString &labels)
+{
+	QMutexLocker locker(&mutex);
+	Series &series = family(name, Type::Histogram).series[labels];
+	if (series.bucketCounts.isEmpty())
+		series.bucketCounts.fill(0, HISTOGRAM_BUCKET_COUNT);
+
+	for (int i = 0; i < HISTOGRAM_BUCKET_COUNT; ++i) {
+		if (value <= HISTOGRAM_BUCKETS[i])
+			series.bucketCounts[i]++;
+	}
+	series.sum += value;
+	series.count++;
+}
+
+QString MetricsRegistry::renderPrometheus() const
+{
+	QMutexLocker locker(&mutex);
+
+	QString output;
+	QTextStream out(&output);
+
+	for (auto it = families.cbegin(); it != families.cend(); ++it) {
+		const QString &name = it.key();
+		const Family &metric = it.value();
+
+		if (const char *help = helpFor(name))
+			out << "# HELP " << name << " " << help << "\n";
+		out << "# TYPE " << name << " " << typeName(metric.type) << "\n";
+
+		for (auto series = metric.series.cbegin(); series != metric.series.cend(); ++series) {
+			const QString &labels = series.key();
+			const Series &data = series.value();
+
+			if (metric.type != Type::Histogram) {
+				out << name << (labels.isEmpty() ? QString() : "{" + labels + "}") << " "
+				    << formatValue(data.value) << "\n";
+				continue;
+			}
+
+			for (int i = 0; i < HISTOGRAM_BUCKET_COUNT; ++i) {
+				QString le = QString("le=\"%1\"").arg(formatValue(HISTOGRAM_BUCKETS[i]));
+				out << name << "_bucket" << joinLabels(labels, le) << " " << data.bucketCounts[i]
+				    << "\n";
+			}
+			out << name << "_bucket" << joinLabels(labels, "le=\"+Inf\"") << " " << data.count << "\n";
+			out << name << "_sum" << (labels.isEmpty() ? QString() : "{" + labels + "}") << " "
+			    << formatValue(data.sum) << "\n";
+			out << name << "_count" << (labels.isEmpty() ? QString() : "{" + labels + "}") << " "
+			    << data.count << "\n";
+		}
+	}
+
+	out.flush();
+	return output;
+}
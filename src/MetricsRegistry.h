@@ -0,0 +1,67 @@
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <initializer_list>
+#include <utility>
+
+class MetricsRegistry {
+public:
+	enum class Type { Counter, Gauge, Histogram };
+
+	static MetricsRegistry &get();
+
+	void incrementCounter(const char *name, const QString &labels = QString(), double value = 1.0);
+	void setGauge(const char *name, double value, const QString &labels = QString());
+	void observe(const char *name, double value, const QString &labels = QString());
+
+	QString renderPrometheus() const;
+
+	static QString labels(std::initializer_list<std::pair<const char *, QString>> pairs);
+
+private:
+	MetricsRegistry() = default;
+
+	struct Series {
+		double value = 0.0;
+		QVector<quint64> bucketCounts;
+		double sum = 0.0;
+		quint64 count = 0;
+	};
+
+	struct Family {
+		Type type = Type::Counter;
+		QMap<QString, Series> series;
+	};
+
+	Family &family(const char *name, Type type);
+
+	mutable QMutex mutex;
+	QMap<QString, Family> families;
+};
+
+// Observes the elapsed time of a scope, in seconds, into a histogram.
+class ScopedMetricsTimer {
+public:
+	explicit ScopedMetricsTimer(const char *name, const QString &labels = QString()) : name(name), labels(labels)
+	{
+		timer.start();
+	}
+	~ScopedMetricsTimer() { MetricsRegistry::get().observe(name, timer.nsecsElapsed() / 1e9, labels); }
+
+	ScopedMetricsTimer(const ScopedMetricsTimer &) = delete;
+	ScopedMetricsTimer &operator=(const ScopedMetricsTimer &) = delete;
+
+private:
+	const char *name;
+	QString labels;
+	QElapsedTimer timer;
+};
+
+#endif // METRICSREGISTRY_H
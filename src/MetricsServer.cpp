@@ -0,0 +1,122 @@
+#include "MetricsServer.h"
+#include "MetricsRegistry.h"
+#include "ConfigManager.h"
+
+#include <obs-module.h>
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QStringList>
+
+MetricsServer::MetricsServer(QObject *parent) : QObject(parent)
+{
+	server = new QTcpServer(this);
+	connect(server, &QTcpServer::newConnection, this, &MetricsServer::onNewConnection);
+}
+
+MetricsServer::~MetricsServer()
+{
+	if (server->isListening())
+		server->close();
+}
+
+void MetricsServer::applySettings()
+{
+	bool enabled = ConfigManager::get().getMetricsEnabled();
+	int port = ConfigManager::get().getMetricsPort();
+
+	if (!enabled) {
+		stop();
+		return;
+	}
+
+	if (server->isListening() && server->serverPort() == port)
+		return;
+
+	start(static_cast<quint16>(port));
+}
+
+bool MetricsServer::start(quint16 port)
+{
+	if (server->isListening())
+		server->close();
+
+	if (!server->listen(QHostAddress::LocalHost, port)) {
+		blog(LOG_ERROR, "[GameDetector/Metrics] Could not start metrics server on port %d: %s", port,
+		     server->errorString().toStdString().c_str());
+		return false;
+	}
+
+	blog(LOG_INFO, "[GameDetector/Metrics] Serving metrics at http://localhost:%d/metrics", port);
+	return true;
+}
+
+void MetricsServer::stop()
+{
+	if (server->isListening()) {
+		server->close();
+		blog(LOG_INFO, "[GameDetector/Metrics] Metrics server stopped.");
+	}
+
+	for (auto sock : clientSockets) {
+		if (sock) {
+			QObject::disconnect(sock, nullptr, this, nullptr);
+			if (sock->isOpen()) {
+				sock->disconnectFromHost();
+				sock->close();
+			}
+			delete sock;
+		}
+	}
+	clientSockets.clear();
+}
+
+bool MetricsServer::isListening() const
+{
+	return server->isListening();
+}
+
+void MetricsServer::onNewConnection()
+{
+	QTcpSocket *clientSocket = server->nextPendingConnection();
+	if (!clientSocket)
+		return;
+
+	clientSockets.append(clientSocket);
+
+	connect(clientSocket, &QTcpSocket::readyRead, this, [clientSocket]() {
+		if (!clientSocket || !clientSocket->isValid())
+			return;
+
+		QString request = clientSocket->readAll();
+		QStringList reqLines = request.split("\r\n");
+		QStringList parts = reqLines.isEmpty() ? QStringList() : reqLines.first().split(" ");
+		if (parts.size() < 2) {
+			clientSocket->write("HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+			clientSocket->disconnectFromHost();
+			return;
+		}
+
+		QString method = parts[0];
+		QString path = parts[1];
+
+		if (method == "GET" && (path == "/metrics" || path.startsWith("/metrics?"))) {
+			QByteArray body = MetricsRegistry::get().renderPrometheus().toUtf8();
+			QByteArray response = "HTTP/1.1 200 OK\r\nConnection: close\r\n"
+					      "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+					      "Content-Length: " +
+					      QByteArray::number(body.size()) + "\r\n\r\n" + body;
+			clientSocket->write(response);
+		} else {
+			clientSocket->write("HTTP/1.1 404 Not Found\r\nConnection: close\r\n\r\n");
+		}
+		clientSocket->disconnectFromHost();
+	});
+
+	connect(clientSocket, &QTcpSocket::disconnected, this, [this, clientSocket]() {
+		if (clientSocket) {
+			clientSocket->deleteLater();
+		}
+		clientSockets.removeAll(clientSocket);
+	});
+}
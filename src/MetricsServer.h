@@ -0,0 +1,40 @@
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QList>
+
+class QTcpServer;
+class QTcpSocket;
+
+// Serves MetricsRegistry in Prometheus text format on a localhost-only port.
+class MetricsServer : public QObject {
+	Q_OBJECT
+
+public:
+	static MetricsServer &get()
+	{
+		static MetricsServer instance;
+		return instance;
+	}
+
+	void applySettings();
+	bool start(quint16 port);
+	void stop();
+	bool isListening() const;
+
+private slots:
+	void onNewConnection();
+
+private:
+	MetricsServer(QObject *parent = nullptr);
+	~MetricsServer();
+
+	QTcpServer *server = nullptr;
+	QList<QPointer<QTcpSocket>> clientSockets;
+};
+
+#endif // METRICSSERVER_H
@@ -0,0 +1,483 @@
+#include "MockPlatformServer.h"
+#include "ConfigManager.h"
+#include "CategoryCache.h"
+
+#include <obs-module.h>
+
+#include <QCoreApplication>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+#include <QPointer>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QUrl>
+
+#include <algorithm>
+
+static const char *TWITCH_USER_ID = "1001";
+static const char *TROVO_USER_ID = "2001";
+static const char *STAND_IN_LOGIN = "standin";
+
+MockPlatformServer::MockPlatformServer() : QObject(nullptr)
+{
+	server = new QTcpServer(this);
+	connect(server, &QTcpServer::newConnection, this, &MockPlatformServer::onNewConnection);
+}
+
+MockPlatformServer::~MockPlatformServer()
+{
+	shutdown();
+}
+
+QString MockPlatformServer::baseUrl() const
+{
+	return QString("http://127.0.0.1:%1").arg(port());
+}
+
+void MockPlatformServer::applySettings()
+{
+	ConfigManager &config = ConfigManager::get();
+	if (!config.getMockPlatformEnabled() && !config.getApiStandInEnabled()) {
+		shutdown();
+		return;
+	}
+
+	int port = config.getMockPlatformPort();
+	int latency = config.getMockPlatformLatencyMs();
+	double errors = config.getMockPlatformErrorRate();
+	double authFailures = config.getMockPlatformAuthFailureRate();
+	int limit = config.getMockPlatformRateLimit();
+
+	if (!thread) {
+		thread = new QThread();
+		thread->setObjectName("GameDetector MockPlatform");
+		moveToThread(thread);
+		thread->start();
+	}
+
+	QMetaObject::invokeMethod(
+		this,
+		[=]() {
+			latencyMs = std::max(0, latency);
+			errorRate = errors;
+			authFailureRate = authFailures;
+			rateLimit = limit;
+			if (!server->isListening() || server->serverPort() != port)
+				start(static_cast<quint16>(port));
+		},
+		Qt::BlockingQueuedConnection);
+}
+
+void MockPlatformServer::shutdown()
+{
+	if (!thread)
+		return;
+
+	QMetaObject::invokeMethod(
+		this,
+		[this]() {
+			stop();
+			// Hand the object back before its thread goes away, so it can be started again.
+			moveToThread(QCoreApplication::instance()->thread());
+		},
+		Qt::BlockingQueuedConnection);
+	thread->quit();
+	thread->wait();
+	delete thread;
+	thread = nullptr;
+}
+
+bool MockPlatformServer::start(quint16 port)
+{
+	if (server->isListening())
+		stop();
+
+	if (!server->listen(QHostAddress::LocalHost, port)) {
+		blog(LOG_ERROR, "[GameDetector/MockPlatform] Could not start API stand-in on port %d: %s", port,
+		     server->errorString().toStdString().c_str());
+		return false;
+	}
+	listeningPort = server->serverPort();
+
+	blog(LOG_INFO, "[GameDetector/MockPlatform] Serving API stand-in at http://127.0.0.1:%d", port);
+	blog(LOG_INFO, "[GameDetector/MockPlatform] Latency %d ms, errors %.2f, auth failures %.2f, limit %d/min.",
+	     latencyMs, errorRate, authFailureRate, rateLimit);
+	return true;
+}
+
+void MockPlatformServer::stop()
+{
+	listeningPort = 0;
+	if (server->isListening())
+		server->close();
+
+	for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+		QTcpSocket *socket = it.key();
+		QObject::disconnect(socket, nullptr, this, nullptr);
+		socket->abort();
+		socket->deleteLater();
+	}
+	buffers.clear();
+}
+
+void MockPlatformServer::onNewConnection()
+{
+	QTcpSocket *socket = server->nextPendingConnection();
+	if (!socket)
+		return;
+
+	buffers.insert(socket, QByteArray());
+
+	connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+		auto it = buffers.find(socket);
+		if (it == buffers.end())
+			return;
+		QByteArray &buffer = it.value();
+		buffer.append(socket->readAll());
+
+		if (buffer.size() > MAX_REQUEST_BYTES) {
+			socket->write(response(413, "Payload Too Large"));
+			socket->disconnectFromHost();
+			return;
+		}
+
+		// Wait until the headers and the whole body announced by Content-Length have arrived.
+		int headerEnd = buffer.indexOf("\r\n\r\n");
+		if (headerEnd < 0)
+			return;
+
+		QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+		QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+		int contentLength = 0;
+		bool keepAlive = requestLine.size() > 2 && requestLine[2] == "HTTP/1.1";
+		for (int i = 1; i < lines.size(); ++i) {
+			int colon = lines[i].indexOf(':');
+			if (colon <= 0)
+				continue;
+			QByteArray name = lines[i].left(colon).trimmed().toLower();
+			QByteArray value = lines[i].mid(colon + 1).trimmed().toLower();
+			if (name == "content-length")
+				contentLength = value.toInt();
+			else if (name == "connection")
+				keepAlive = value != "close";
+		}
+		if (buffer.size() < headerEnd + 4 + contentLength)
+			return;
+
+		QByteArray body = buffer.mid(headerEnd + 4, contentLength);
+		// Anything after this request belongs to the next one on the same connection.
+		buffer.remove(0, headerEnd + 4 + contentLength);
+		if (requestLine.size() < 2) {
+			socket->write(response(400, "Bad Request"));
+			socket->disconnectFromHost();
+			return;
+		}
+
+		Request request;
+		request.method = requestLine[0];
+		QUrl target(QString::fromUtf8(requestLine[1]));
+		request.path = target.path().toUtf8();
+		request.query = QUrlQuery(target);
+		request.body = body;
+		handleRequest(socket, request, keepAlive);
+	});
+
+	connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+		buffers.remove(socket);
+		socket->deleteLater();
+	});
+}
+
+void MockPlatformServer::handleRequest(QTcpSocket *socket, const Request &request, bool keepAlive)
+{
+	qint64 now = QDateTime::currentSecsSinceEpoch();
+	if (now - windowStart >= RATE_LIMIT_WINDOW_SECONDS) {
+		windowStart = now;
+		windowCount = 0;
+	}
+	windowCount++;
+
+	// Limits and faults are decided when the request arrives, like on a real server; only the
+	// answer is delayed. Browser redirects of the login flows are never failed.
+	bool injectable = !request.path.startsWith("/page/") && request.path != "/oauth2/authorize" &&
+			  !(request.path == "/trovo" && request.method == "GET");
+	double roll = QRandomGenerator::global()->generateDouble();
+	QByteArray reply;
+	if (injectable && rateLimit > 0 && windowCount > rateLimit) {
+		qint64 retryAfter = std::max<qint64>(1, windowStart + RATE_LIMIT_WINDOW_SECONDS - now);
+		reply = response(429, "Too Many Requests",
+				 rateLimitHeaders(now) + "Retry-After: " + QByteArray::number(retryAfter) + "\r\n");
+	} else if (injectable && roll < authFailureRate) {
+		reply = response(401, "Unauthorized", rateLimitHeaders(now));
+	} else if (injectable && roll < authFailureRate + errorRate) {
+		static const struct {
+			int code;
+			const char *reason;
+		} faults[] = {{500, "Internal Server Error"}, {502, "Bad Gateway"}, {503, "Service Unavailable"}};
+		const auto &fault = faults[QRandomGenerator::global()->bounded(3)];
+		reply = response(fault.code, fault.reason, rateLimitHeaders(now));
+	} else {
+		reply = route(request);
+	}
+
+	if (!keepAlive)
+		reply.insert(reply.indexOf("\r\n") + 2, "Connection: close\r\n");
+
+	QPointer<QTcpSocket> target(socket);
+	QTimer::singleShot(latencyMs, this, [target, reply, keepAlive]() {
+		if (!target || !target->isValid())
+			return;
+		target->write(reply);
+		if (!keepAlive)
+			target->disconnectFromHost();
+	});
+}
+
+QByteArray MockPlatformServer::route(const Request &request)
+{
+	QByteArray headers = rateLimitHeaders(QDateTime::currentSecsSinceEpoch());
+
+	if (request.path.startsWith("/oauth2/") || request.path.startsWith("/helix/"))
+		return routeTwitch(request, headers);
+	if (request.path.startsWith("/openplatform/") || request.path.startsWith("/page/") || request.path == "/trovo")
+		return routeTrovo(request, headers);
+	return routeMock(request, headers);
+}
+
+QByteArray MockPlatformServer::routeTwitch(const Request &request, const QByteArray &headers)
+{
+	const QByteArray &path = request.path;
+	const QByteArray &method = request.method;
+	Channel &channel = channels["twitch"];
+
+	if (path == "/oauth2/authorize" && method == "GET") {
+		QString token = QString("standin-twitch-%1").arg(++issuedTokens);
+		return redirect(request.query.queryItemValue("redirect_uri", QUrl::FullyDecoded) +
+				"#access_token=" + token + "&token_type=bearer");
+	}
+
+	if (path == "/oauth2/validate" && method == "GET") {
+		QJsonObject info;
+		info["client_id"] = "standin";
+		info["login"] = STAND_IN_LOGIN;
+		info["user_id"] = TWITCH_USER_ID;
+		info["scopes"] = QJsonArray({"user:write:chat", "channel:manage:broadcast"});
+		info["expires_in"] = TOKEN_LIFETIME_SECONDS;
+		return jsonResponse(headers, info);
+	}
+
+	if (path == "/helix/users" && method == "GET") {
+		QJsonObject user;
+		user["id"] = TWITCH_USER_ID;
+		user["login"] = STAND_IN_LOGIN;
+		user["display_name"] = STAND_IN_LOGIN;
+		QJsonObject result;
+		result["data"] = QJsonArray({user});
+		return jsonResponse(headers, result);
+	}
+
+	if (path == "/helix/games" && method == "GET") {
+		// Every name exists, so batched lookups get one entry per requested name.
+		QJsonArray games;
+		for (const QString &name : request.query.allQueryItemValues("name", QUrl::FullyDecoded)) {
+			QJsonObject game;
+			game["id"] = gameId(name);
+			game["name"] = name;
+			games.append(game);
+		}
+		QJsonObject result;
+		result["data"] = games;
+		return jsonResponse(headers, result);
+	}
+
+	if (path == "/helix/channels" && method == "GET") {
+		QJsonObject info;
+		info["broadcaster_id"] = TWITCH_USER_ID;
+		info["game_id"] = gameId(channel.category);
+		info["game_name"] = channel.category;
+		info["title"] = channel.title;
+		QJsonObject result;
+		result["data"] = QJsonArray({info});
+		return jsonResponse(headers, result);
+	}
+
+	if (path == "/helix/channels" && method == "PATCH") {
+		QJsonObject update = QJsonDocument::fromJson(request.body).object();
+		QString name = gameNames.value(update["game_id"].toString());
+		if (name.isEmpty())
+			return response(400, "Bad Request", headers);
+		channel.category = name;
+		if (update.contains("title"))
+			channel.title = update["title"].toString();
+		return response(204, "No Content", headers);
+	}
+
+	if (path == "/helix/chat/messages" && method == "POST") {
+		if (QJsonDocument::fromJson(request.body).object()["message"].toString().isEmpty())
+			return response(400, "Bad Request", headers);
+		QJsonObject sent;
+		sent["message_id"] = QString::number(QRandomGenerator::global()->generate());
+		sent["is_sent"] = true;
+		QJsonObject result;
+		result["data"] = QJsonArray({sent});
+		return jsonResponse(headers, result);
+	}
+
+	return response(404, "Not Found", headers);
+}
+
+QByteArray MockPlatformServer::routeTrovo(const Request &request, const QByteArray &headers)
+{
+	const QByteArray &path = request.path;
+	const QByteArray &method = request.method;
+	Channel &channel = channels["trovo"];
+
+	if (path == "/page/login.html" && method == "GET") {
+		QString redirectUri = request.query.queryItemValue("redirect_uri", QUrl::FullyDecoded);
+		return redirect(redirectUri + "?code=standin-code");
+	}
+
+	// Like trovo/index.php, the relay hands the exchanged token to the plugin's local listener.
+	if (path == "/trovo" && method == "GET") {
+		if (!request.query.hasQueryItem("code"))
+			return response(400, "Bad Request", headers);
+		return redirect(QString("http://localhost:31000/?token=standin-trovo-%1&refresh_token=standin-refresh")
+					.arg(++issuedTokens));
+	}
+
+	if (path == "/trovo" && method == "POST") {
+		QJsonObject input = QJsonDocument::fromJson(request.body).object();
+		if (input["grant_type"].toString() != "refresh_token" || input["refresh_token"].toString().isEmpty())
+			return response(400, "Bad Request", headers);
+		QJsonObject tokens;
+		tokens["access_token"] = QString("standin-trovo-%1").arg(++issuedTokens);
+		tokens["refresh_token"] = "standin-refresh";
+		tokens["expires_in"] = TOKEN_LIFETIME_SECONDS;
+		return jsonResponse(headers, tokens);
+	}
+
+	if (path == "/openplatform/validate" && method == "GET") {
+		QJsonObject info;
+		info["uid"] = TROVO_USER_ID;
+		info["nick_name"] = STAND_IN_LOGIN;
+		info["expire_ts"] = QString::number(QDateTime::currentSecsSinceEpoch() + TOKEN_LIFETIME_SECONDS);
+		return jsonResponse(headers, info);
+	}
+
+	if (path == "/openplatform/searchcategory" && method == "POST") {
+		QString query = QJsonDocument::fromJson(request.body).object()["query"].toString();
+		QJsonArray categories;
+		if (!query.isEmpty()) {
+			QJsonObject category;
+			category["id"] = gameId(query);
+			category["name"] = query;
+			categories.append(category);
+		}
+		QJsonObject result;
+		result["category_info"] = categories;
+		return jsonResponse(headers, result);
+	}
+
+	if (path == "/openplatform/channel" && method == "GET") {
+		QJsonObject info;
+		info["channel_id"] = TROVO_USER_ID;
+		info["category_id"] = gameId(channel.category);
+		info["category_name"] = channel.category;
+		info["live_title"] = channel.title;
+		return jsonResponse(headers, info);
+	}
+
+	if (path == "/openplatform/channels/update" && method == "POST") {
+		QJsonObject update = QJsonDocument::fromJson(request.body).object();
+		QString name = gameNames.value(update["category_id"].toString());
+		if (name.isEmpty())
+			return response(400, "Bad Request", headers);
+		channel.category = name;
+		if (update.contains("title"))
+			channel.title = update["title"].toString();
+		return jsonResponse(headers, QJsonObject());
+	}
+
+	if (path == "/openplatform/chat/send" && method == "POST") {
+		if (QJsonDocument::fromJson(request.body).object()["content"].toString().isEmpty())
+			return response(400, "Bad Request", headers);
+		return jsonResponse(headers, QJsonObject());
+	}
+
+	return response(404, "Not Found", headers);
+}
+
+QByteArray MockPlatformServer::routeMock(const Request &request, const QByteArray &headers)
+{
+	Channel &channel = channels["mock"];
+
+	if (request.path == "/channel" && request.method == "GET") {
+		QJsonObject info;
+		info["category"] = channel.category;
+		info["title"] = channel.title;
+		return jsonResponse(headers, info);
+	}
+
+	if (request.path == "/channel" && request.method == "PATCH") {
+		QJsonObject update = QJsonDocument::fromJson(request.body).object();
+		if (update["category"].toString().isEmpty())
+			return response(400, "Bad Request", headers);
+		channel.category = update["category"].toString();
+		if (update.contains("title"))
+			channel.title = update["title"].toString();
+		return response(204, "No Content", headers);
+	}
+
+	if (request.path == "/chat" && request.method == "POST") {
+		if (QJsonDocument::fromJson(request.body).object()["message"].toString().isEmpty())
+			return response(400, "Bad Request", headers);
+		return response(200, "OK", headers);
+	}
+
+	return response(404, "Not Found", headers);
+}
+
+QString MockPlatformServer::gameId(const QString &name)
+{
+	QString key = CategoryCache::normalize(name);
+	auto it = gameIds.constFind(key);
+	if (it != gameIds.cend())
+		return it.value();
+
+	QString id = QString::number(10000 + gameIds.size());
+	gameIds.insert(key, id);
+	gameNames.insert(id, name);
+	return id;
+}
+
+QByteArray MockPlatformServer::rateLimitHeaders(qint64 nowSecs) const
+{
+	if (rateLimit <= 0)
+		return QByteArray();
+	int remaining = std::max(0, rateLimit - windowCount);
+	qint64 reset = std::max(windowStart, nowSecs - RATE_LIMIT_WINDOW_SECONDS) + RATE_LIMIT_WINDOW_SECONDS;
+	return "Ratelimit-Limit: " + QByteArray::number(rateLimit) + "\r\nRatelimit-Remaining: " +
+	       QByteArray::number(remaining) + "\r\nRatelimit-Reset: " + QByteArray::number(reset) + "\r\n";
+}
+
+QByteArray MockPlatformServer::response(int code, const char *reason, const QByteArray &headers,
+					const QByteArray &body)
+{
+	return "HTTP/1.1 " + QByteArray::number(code) + " " + reason + "\r\n" + headers +
+	       "Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n" + body;
+}
+
+QByteArray MockPlatformServer::jsonResponse(const QByteArray &headers, const QJsonObject &body)
+{
+	return response(200, "OK", headers + "Content-Type: application/json\r\n",
+			QJsonDocument(body).toJson(QJsonDocument::Compact));
+}
+
+QByteArray MockPlatformServer::redirect(const QString &location)
+{
+	return response(302, "Found", "Location: " + location.toUtf8() + "\r\n");
+}
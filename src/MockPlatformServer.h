@@ -0,0 +1,107 @@
+#ifndef MOCKPLATFORMSERVER_H
+#define MOCKPLATFORMSERVER_H
+
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QByteArray>
+#include <QString>
+#include <QUrlQuery>
+#include <QJsonObject>
+
+#include <atomic>
+
+class QTcpServer;
+class QTcpSocket;
+class QThread;
+
+// Local stand-in for the platform APIs on a localhost-only port, used for integration tests and
+// latency benchmarks without live credentials. It runs on its own thread so a request made from
+// the UI thread cannot deadlock on it, and serves:
+//   /oauth2/...        Twitch authorize (redirects with a token) and validate
+//   /helix/...         Twitch users, games, channels GET/PATCH and chat/messages
+//   /page/login.html   Trovo login (redirects to the relay with a code)
+//   /openplatform/...  Trovo validate, searchcategory, channel, channels/update and chat/send
+//   /trovo             the token relay of trovo/index.php: code exchange and refresh_token
+//   /channel, /chat    the generic API of MockPlatformService
+// Each platform keeps its channel in memory. Every answer is delayed by the configured latency, a
+// share of requests fails with 401 or 5xx, and requests beyond the per-minute limit get 429 with
+// the Ratelimit-* and Retry-After headers the real platforms send, so NetworkEngine's limiter,
+// retries and circuit breaker react as they would in production.
+//
+// Point the plugin at it with api_stand_in_enabled, or set the *_base_url keys in the plugin config.
+class MockPlatformServer : public QObject {
+	Q_OBJECT
+
+public:
+	static MockPlatformServer &get()
+	{
+		static MockPlatformServer instance;
+		return instance;
+	}
+
+	// Starts, reconfigures or stops the server from mock_platform_* and api_stand_in_enabled.
+	void applySettings();
+	void shutdown();
+	bool isListening() const { return listeningPort.load() != 0; }
+	quint16 port() const { return static_cast<quint16>(listeningPort.load()); }
+	QString baseUrl() const;
+
+private slots:
+	void onNewConnection();
+
+private:
+	MockPlatformServer();
+	~MockPlatformServer();
+
+	struct Request {
+		QByteArray method;
+		QByteArray path;
+		QUrlQuery query;
+		QByteArray body;
+	};
+	struct Channel {
+		QString category = "Just Chatting";
+		QString title;
+	};
+
+	bool start(quint16 port);
+	void stop();
+	void handleRequest(QTcpSocket *socket, const Request &request, bool keepAlive);
+	QByteArray route(const Request &request);
+	QByteArray routeTwitch(const Request &request, const QByteArray &headers);
+	QByteArray routeTrovo(const Request &request, const QByteArray &headers);
+	QByteArray routeMock(const Request &request, const QByteArray &headers);
+	QString gameId(const QString &name);
+	QByteArray rateLimitHeaders(qint64 nowSecs) const;
+	static QByteArray response(int code, const char *reason, const QByteArray &headers = QByteArray(),
+				   const QByteArray &body = QByteArray());
+	static QByteArray jsonResponse(const QByteArray &headers, const QJsonObject &body);
+	static QByteArray redirect(const QString &location);
+
+	QThread *thread = nullptr;
+	QTcpServer *server = nullptr;
+	std::atomic<int> listeningPort{0};
+	// Bytes received per connection until a complete request has arrived.
+	QHash<QTcpSocket *, QByteArray> buffers;
+
+	// Only touched on the server thread.
+	int latencyMs = 0;
+	double errorRate = 0.0;
+	double authFailureRate = 0.0;
+	int rateLimit = 0;
+	qint64 windowStart = 0;
+	int windowCount = 0;
+	QHash<QString, Channel> channels;
+	// Normalized game name to its id, and back to the name as first seen.
+	QHash<QString, QString> gameIds;
+	QHash<QString, QString> gameNames;
+	int issuedTokens = 0;
+
+	static constexpr int RATE_LIMIT_WINDOW_SECONDS = 60;
+	static constexpr int MAX_REQUEST_BYTES = 64 * 1024;
+	static constexpr int TOKEN_LIFETIME_SECONDS = 4 * 60 * 60;
+};
+
+#endif // MOCKPLATFORMSERVER_H
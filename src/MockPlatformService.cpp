@@ -0,0 +1,105 @@
+#include "MockPlatformService.h"
+#include "MockPlatformServer.h"
+#include "ApiEndpoints.h"
+#include <obs-module.h>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+MockPlatformService::MockPlatformService(QObject *parent) : IPlatformService(parent)
+{
+	updateWatcher = new QFutureWatcher<long>(this);
+	messageWatcher = new QFutureWatcher<bool>(this);
+
+	connect(updateWatcher, &QFutureWatcher<long>::finished, this, [this]() {
+		QString gameName = updateWatcher->property("gameName").toString();
+		long httpCode = updateWatcher->result();
+		if (httpCode == 204) {
+			emit categoryUpdateFinished(true, gameName, "");
+		} else {
+			emit categoryUpdateFinished(false, gameName,
+						    QString("Mock platform answered HTTP %1").arg(httpCode));
+		}
+	});
+
+	connect(messageWatcher, &QFutureWatcher<bool>::finished, this, [this]() {
+		emit messageSent(messageWatcher->result(), messageWatcher->property("message").toString());
+	});
+}
+
+bool MockPlatformService::isAuthenticated() const
+{
+	return MockPlatformServer::get().isListening();
+}
+
+NetworkRequest MockPlatformService::buildRequest(const QString &method, const QString &path, const QByteArray &body)
+{
+	NetworkRequest request;
+	request.url = MockPlatformServer::get().baseUrl() + path;
+	request.circuit = ApiEndpoints::circuit(platformId(), request.url);
+	request.method = method;
+	request.body = body;
+	if (!body.isEmpty())
+		request.headers.push_back("Content-Type: application/json");
+	request.timeoutMs = 10000;
+	return request;
+}
+
+void MockPlatformService::updateCategory(const QString &gameName, const QString &title)
+{
+	if (!isAuthenticated()) {
+		emit categoryUpdateFinished(false, gameName, "Mock platform is not running");
+		return;
+	}
+
+	QJsonObject update;
+	update["category"] = gameName;
+	if (!title.isEmpty())
+		update["title"] = title;
+
+	QByteArray body = QJsonDocument(update).toJson(QJsonDocument::Compact);
+	NetworkRequest request = buildRequest("PATCH", "/channel", body);
+	request.priority = NetworkRequest::Priority::High;
+	request.idempotent = true;
+
+	updateWatcher->setProperty("gameName", gameName);
+	updateWatcher->setFuture(NetworkEngine::get().submitMapped<long>(
+		request, "MockPlatform/updateCategory",
+		[](const NetworkResponse &response) { return response.httpCode; }));
+}
+
+void MockPlatformService::sendChatMessage(const QString &message)
+{
+	if (!isAuthenticated())
+		return;
+
+	QJsonObject chat;
+	chat["message"] = message;
+	NetworkRequest request = buildRequest("POST", "/chat", QJsonDocument(chat).toJson(QJsonDocument::Compact));
+	request.priority = NetworkRequest::Priority::High;
+
+	messageWatcher->setProperty("message", message);
+	messageWatcher->setFuture(NetworkEngine::get().submitMapped<bool>(
+		request, "MockPlatform/sendChatMessage",
+		[](const NetworkResponse &response) { return response.isSuccess(); }));
+}
+
+QFuture<ChannelState> MockPlatformService::getChannelState()
+{
+	NetworkRequest request = buildRequest("GET", "/channel");
+	request.priority = NetworkRequest::Priority::Low;
+
+	return NetworkEngine::get().submitMapped<ChannelState>(
+		request, "MockPlatform/getChannelState", [](const NetworkResponse &response) -> ChannelState {
+			ChannelState state;
+			if (!response.isSuccess()) {
+				state.category = QString("Erro: HTTP %1").arg(response.httpCode);
+				return state;
+			}
+			QJsonObject channel = QJsonDocument::fromJson(response.body).object();
+			state.category = channel["category"].toString();
+			state.title = channel["title"].toString();
+			state.valid = !state.category.isEmpty();
+			return state;
+		});
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "IPlatformService.h"
+#include "NetworkEngine.h"
+#include <QFutureWatcher>
+
+// Platform backed by the generic /channel and /chat API of MockPlatformServer. It goes through
+// NetworkEngine like the real platforms, so load tests exercise the same pipelines, rate limiting
+// and circuit breaking.
+// Enabled with mock_platform_enabled in the plugin config; it has no entry in the settings dialog.
+class MockPlatformService : public IPlatformService {
+	Q_OBJECT
+public:
+	explicit MockPlatformService(QObject *parent = nullptr);
+	QString platformId() const override { return "Mock"; }
+	int capabilities() const override { return UpdateCategory | UpdateTitle | SendChat | ReadChannelState; }
+	void updateCategory(const QString &gameName, const QString &title = QString()) override;
+	void sendChatMessage(const QString &message) override;
+	bool isAuthenticated() const override;
+	QFuture<ChannelState> getChannelState() override;
+
+private:
+	NetworkRequest buildRequest(const QString &method, const QString &path, const QByteArray &body = QByteArray());
+
+	QFutureWatcher<long> *updateWatcher;
+	QFutureWatcher<bool> *messageWatcher;
+};
@@ -0,0 +1,106 @@
+#include "NetworkCommon.h"
+#include "NetworkEngine.h"
+
+CurlHandlePool &CurlHandlePool::get()
+{
+	static CurlHandlePool instance;
+	return instance;
+}
+
+CurlHandlePool::CurlHandlePool()
+{
+	share = curl_share_init();
+	if (!share) {
+		blog(LOG_WARNING, "[NetworkCommon] Could not create cURL share handle. DNS and TLS caches disabled.");
+		return;
+	}
+
+	curl_share_setopt(share, CURLSHOPT_LOCKFUNC, &CurlHandlePool::lockShare);
+	curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &CurlHandlePool::unlockShare);
+	curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+	curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+	curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+	// Live connections are cached by the NetworkEngine multi handle, not by the share.
+}
+
+CurlHandlePool::~CurlHandlePool()
+{
+	shutdown();
+}
+
+void CurlHandlePool::lockShare(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr)
+{
+	(void)handle;
+	(void)access;
+	auto *pool = static_cast<CurlHandlePool *>(userptr);
+	pool->shareLocks[data].lock();
+}
+
+void CurlHandlePool::unlockShare(CURL *handle, curl_lock_data data, void *userptr)
+{
+	(void)handle;
+	auto *pool = static_cast<CurlHandlePool *>(userptr);
+	pool->shareLocks[data].unlock();
+}
+
+CURL *CurlHandlePool::acquire(const std::string &host)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = idleHandles.find(host);
+		if (it != idleHandles.end() && !it->second.empty()) {
+			CURL *handle = it->second.back();
+			it->second.pop_back();
+			return handle;
+		}
+		if (shuttingDown)
+			return nullptr;
+	}
+
+	CURL *handle = curl_easy_init();
+	if (handle && share)
+		curl_easy_setopt(handle, CURLOPT_SHARE, share);
+	return handle;
+}
+
+void CurlHandlePool::release(const std::string &host, CURL *handle)
+{
+	if (!handle)
+		return;
+
+	// Options are cleared, but the shared DNS and TLS session data survive the reset.
+	curl_easy_reset(handle);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto &idle = idleHandles[host];
+		if (!shuttingDown && idle.size() < MAX_IDLE_PER_HOST) {
+			idle.push_back(handle);
+			return;
+		}
+	}
+
+	curl_easy_cleanup(handle);
+}
+
+void CurlHandlePool::shutdown()
+{
+	std::map<std::string, std::vector<CURL *>> handles;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (shuttingDown)
+			return;
+		shuttingDown = true;
+		handles.swap(idleHandles);
+	}
+
+	for (auto &entry : handles) {
+		for (CURL *handle : entry.second)
+			curl_easy_cleanup(handle);
+	}
+
+	if (share) {
+		curl_share_cleanup(share);
+		share = nullptr;
+	}
+}
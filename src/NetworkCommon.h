@@ -4,62 +4,40 @@
 #include <curl/curl.h>
 #include <QString>
 #include <obs-module.h>
+#include "NetworkEngine.h"
 #include <QtConcurrent/QtConcurrent>
 #include <QThreadPool>
 #include <exception>
+#include <map>
+#include <mutex>
 #include <utility>
+#include <vector>
 
-static size_t auth_curl_write_callback(void *contents, size_t size, size_t nmemb, void *userp)
-{
-	size_t realsize = size * nmemb;
-	((std::string *)userp)->append((char *)contents, realsize);
-	return realsize;
-}
-
-inline std::pair<long, QString> ExecuteNetworkRequest(const QString &url, const QString &method,
-						      struct curl_slist *headers, const std::string &body = "",
-						      bool verbose = false)
-{
-	CURL *curl = curl_easy_init();
-	if (!curl)
-		return {0, ""};
-
-	long http_code = 0;
-	std::string response;
+// Keeps finished easy handles alive per host so NetworkEngine does not rebuild them for every
+// request. All handles share one DNS cache and one TLS session cache.
+class CurlHandlePool {
+public:
+	static CurlHandlePool &get();
 
-	curl_easy_setopt(curl, CURLOPT_URL, url.toStdString().c_str());
-	curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, auth_curl_write_callback);
-	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-	curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
+	CURL *acquire(const std::string &host);
+	void release(const std::string &host, CURL *handle);
+	void shutdown();
 
-	if (verbose) {
-		curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
-	}
+private:
+	CurlHandlePool();
+	~CurlHandlePool();
 
-	curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);
-	curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+	static void lockShare(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr);
+	static void unlockShare(CURL *handle, curl_lock_data data, void *userptr);
 
-	if (method == "POST") {
-		curl_easy_setopt(curl, CURLOPT_POST, 1L);
-		curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-	} else if (method == "PATCH") {
-		curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PATCH");
-		curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-	}
+	CURLSH *share = nullptr;
+	std::mutex shareLocks[CURL_LOCK_DATA_LAST];
+	std::mutex mutex;
+	std::map<std::string, std::vector<CURL *>> idleHandles;
+	bool shuttingDown = false;
 
-	CURLcode res = curl_easy_perform(curl);
-	curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-
-	curl_easy_cleanup(curl);
-
-	if (res != CURLE_OK) {
-		blog(LOG_ERROR, "[NetworkCommon] cURL error: %s", curl_easy_strerror(res));
-		return {0, ""};
-	}
-
-	return {http_code, QString::fromStdString(response)};
-}
+	static constexpr size_t MAX_IDLE_PER_HOST = 4;
+};
 
 template<typename Func>
 auto RunTaskSafe(QThreadPool *pool, const char *context, Func &&func) -> QFuture<decltype(func())>
@@ -0,0 +1,868 @@
+#include "NetworkEngine.h"
+#include "NetworkCommon.h"
+#include "Tracer.h"
+#include "MetricsRegistry.h"
+
+#include <QRandomGenerator>
+#include <QUrl>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+int NetworkEngine::progressCallback(void *clientp, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+{
+	// Called at least once a second while a transfer runs, including while it connects or waits
+	// for the server, so shutdown does not have to wait for a slow response or a timeout.
+	return static_cast<NetworkEngine *>(clientp)->running ? 0 : 1;
+}
+
+size_t NetworkEngine::writeCallback(void *contents, size_t size, size_t nmemb, void *userp)
+{
+	size_t realsize = size * nmemb;
+	static_cast<Transfer *>(userp)->response.append(static_cast<const char *>(contents),
+							  static_cast<int>(realsize));
+	return realsize;
+}
+
+size_t NetworkEngine::headerCallback(char *buffer, size_t size, size_t nitems, void *userdata)
+{
+	size_t realsize = size * nitems;
+	auto *transfer = static_cast<Transfer *>(userdata);
+	std::map<std::string, std::string> &headers = transfer->responseHeaders;
+	std::string line(buffer, realsize);
+
+	// A new status line starts the headers of another response (redirect or 100 Continue).
+	if (line.compare(0, 5, "HTTP/") == 0) {
+		headers.clear();
+		return realsize;
+	}
+
+	size_t colon = line.find(':');
+	if (colon == std::string::npos)
+		return realsize;
+
+	std::string name = line.substr(0, colon);
+	std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+	size_t start = line.find_first_not_of(" \t", colon + 1);
+	size_t end = line.find_last_not_of(" \t\r\n");
+	std::string value = (start == std::string::npos || end < start) ? std::string()
+									: line.substr(start, end - start + 1);
+
+	// Size the receive buffer once instead of growing it chunk by chunk.
+	if (name == "content-length") {
+		long long length = std::atoll(value.c_str());
+		if (length > 0 && length <= MAX_PREALLOCATED_BODY)
+			transfer->response.reserve(static_cast<int>(length));
+	}
+
+	headers[name] = std::move(value);
+	return realsize;
+}
+
+NetworkEngine &NetworkEngine::get()
+{
+	static NetworkEngine instance;
+	return instance;
+}
+
+NetworkEngine::NetworkEngine()
+{
+	multi = curl_multi_init();
+	if (!multi) {
+		blog(LOG_ERROR, "[GameDetector/NetworkEngine] Could not create cURL multi handle.");
+		shuttingDown = true;
+		return;
+	}
+
+	// Concurrent requests to one host share a single HTTP/2 connection where the server allows it.
+	curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+	curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, MAX_CONNECTIONS_PER_HOST);
+
+	running = true;
+	reactor = std::thread(&NetworkEngine::run, this);
+}
+
+NetworkEngine::~NetworkEngine()
+{
+	shutdown();
+}
+
+NetworkEngine::RequestId NetworkEngine::submit(const NetworkRequest &request, Callback callback)
+{
+	auto transfer = std::make_unique<Transfer>();
+	transfer->id = nextId++;
+	transfer->request = request;
+	transfer->callback = std::move(callback);
+	transfer->host = QUrl(request.url).host().toStdString();
+	transfer->circuit = request.circuit.empty() ? transfer->host : request.circuit;
+	transfer->flightKey = flightKeyFor(request);
+	transfer->rateBucket = rateBucketFor(request, transfer->host);
+	RequestId id = transfer->id;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!shuttingDown && !request.cancellation.isCancelled()) {
+			if (!transfer->flightKey.empty()) {
+				auto flight = flights.find(transfer->flightKey);
+				if (flight != flights.end()) {
+					followers[flight->second].push_back(
+						Follower{id, std::move(transfer->callback), request.cancellation});
+					liveIds.insert(id);
+					MetricsRegistry::get().incrementCounter("gamedetector_http_coalesced_requests_total");
+					return id;
+				}
+				flights[transfer->flightKey] = id;
+			}
+			liveIds.insert(id);
+			queueFor(request.priority).push_back(std::move(transfer));
+		}
+	}
+
+	if (transfer) {
+		NetworkResponse response;
+		response.cancelled = true;
+		if (transfer->callback)
+			transfer->callback(response);
+		return id;
+	}
+
+	curl_multi_wakeup(multi);
+	return id;
+}
+
+QFuture<NetworkResponse> NetworkEngine::submit(const NetworkRequest &request, RequestId *id)
+{
+	auto promise = std::make_shared<QFutureInterface<NetworkResponse>>();
+	promise->reportStarted();
+	QFuture<NetworkResponse> future = promise->future();
+
+	RequestId requestId = submit(request, [promise](const NetworkResponse &response) {
+		promise->reportResult(response);
+		promise->reportFinished();
+	});
+	if (id)
+		*id = requestId;
+	return future;
+}
+
+bool NetworkEngine::cancel(RequestId id)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (liveIds.find(id) == liveIds.end())
+			return false;
+		cancelRequests.push_back(id);
+	}
+	curl_multi_wakeup(multi);
+	return true;
+}
+
+void NetworkEngine::cancel(const CancellationToken &token)
+{
+	if (!token.flag)
+		return;
+	token.flag->store(true, std::memory_order_relaxed);
+	tokenCancelled = true;
+	if (multi)
+		curl_multi_wakeup(multi);
+}
+
+void NetworkEngine::setKeepAliveTargets(const std::vector<QString> &urls)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (shuttingDown)
+			return;
+		keepAliveTargets = urls;
+		keepAliveTargetsChanged = true;
+	}
+	curl_multi_wakeup(multi);
+}
+
+void NetworkEngine::shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (shuttingDown && !running)
+			return;
+		shuttingDown = true;
+	}
+
+	// The reactor is always joined: it runs module code and uses the handle pool, so neither may
+	// go away while it is alive.
+	int64_t startMs = RateLimiter::nowMs();
+	running = false;
+	if (multi)
+		curl_multi_wakeup(multi);
+	if (reactor.joinable())
+		reactor.join();
+
+	if (multi) {
+		curl_multi_cleanup(multi);
+		multi = nullptr;
+	}
+
+	int64_t elapsedMs = RateLimiter::nowMs() - startMs;
+	if (elapsedMs > SHUTDOWN_BUDGET_MS) {
+		blog(LOG_WARNING, "[GameDetector/NetworkEngine] Aborting network I/O took %lld ms.",
+		     static_cast<long long>(elapsedMs));
+	}
+}
+
+void NetworkEngine::setCircuitListener(CircuitBreaker::Listener listener)
+{
+	circuitBreaker.setListener(std::move(listener));
+}
+
+std::string NetworkEngine::flightKeyFor(const NetworkRequest &request)
+{
+	if (!request.coalesce || request.method != "GET")
+		return std::string();
+
+	// Priority and timeout are part of the key, so a caller never inherits another's scheduling.
+	std::string key = request.url.toStdString();
+	key += '\n';
+	key += std::to_string(static_cast<int>(request.priority));
+	key += '\n';
+	key += std::to_string(request.timeoutMs);
+	if (request.headerSet) {
+		// Header sets are cached per token, so equal requests share the same set.
+		key += '\n';
+		key += std::to_string(reinterpret_cast<uintptr_t>(request.headerSet.get()));
+	}
+	for (const std::string &header : request.headers) {
+		key += '\n';
+		key += header;
+	}
+	return key;
+}
+
+std::string NetworkEngine::rateBucketFor(const NetworkRequest &request, const std::string &host)
+{
+	// Budgets are per token; only a hash of it is kept so the bucket key can be logged.
+	if (request.headerSet && !request.headerSet->authorizationKey().empty())
+		return host + "#" + request.headerSet->authorizationKey();
+	for (const std::string &header : request.headers) {
+		std::string name = header.substr(0, header.find(':'));
+		std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+		if (name == "authorization")
+			return host + "#" + std::to_string(std::hash<std::string>{}(header));
+	}
+	return host;
+}
+
+std::deque<std::unique_ptr<NetworkEngine::Transfer>> &NetworkEngine::queueFor(NetworkRequest::Priority priority)
+{
+	switch (priority) {
+	case NetworkRequest::Priority::High:
+		return highQueue;
+	case NetworkRequest::Priority::Low:
+		return lowQueue;
+	default:
+		return normalQueue;
+	}
+}
+
+void NetworkEngine::run()
+{
+	while (running) {
+		processCancellations();
+		sendKeepAlives(RateLimiter::nowMs());
+		startPendingTransfers();
+
+		int stillRunning = 0;
+		curl_multi_perform(multi, &stillRunning);
+
+		int queued = 0;
+		while (CURLMsg *message = curl_multi_info_read(multi, &queued)) {
+			if (message->msg != CURLMSG_DONE)
+				continue;
+
+			CURL *handle = message->easy_handle;
+			CURLcode result = message->data.result;
+			char *priv = nullptr;
+			curl_easy_getinfo(handle, CURLINFO_PRIVATE, &priv);
+			auto *finished = reinterpret_cast<Transfer *>(priv);
+			curl_multi_remove_handle(multi, handle);
+
+			auto it = finished ? active.find(finished->id) : active.end();
+			if (it == active.end())
+				continue;
+			std::unique_ptr<Transfer> transfer = std::move(it->second);
+			active.erase(it);
+			finishTransfer(std::move(transfer), result, false);
+		}
+
+		if (active.size() != reportedActive) {
+			reportedActive = active.size();
+			MetricsRegistry::get().setGauge("gamedetector_http_inflight_requests",
+							static_cast<double>(reportedActive));
+		}
+
+		curl_multi_poll(multi, nullptr, 0, pollTimeoutMs(), nullptr);
+	}
+
+	failAll();
+}
+
+bool NetworkEngine::isCancelled(const Transfer &transfer, const std::vector<RequestId> &ids, bool sweepTokens) const
+{
+	if (sweepTokens && transfer.request.cancellation.isCancelled())
+		return true;
+	return std::find(ids.begin(), ids.end(), transfer.id) != ids.end();
+}
+
+bool NetworkEngine::isAbandoned(Transfer &transfer, const std::vector<RequestId> &ids, bool sweepTokens,
+				std::vector<Callback> &cancelledCallbacks)
+{
+	auto waiting = followers.find(transfer.id);
+	bool hasFollowers = waiting != followers.end() && !waiting->second.empty();
+	if (!transfer.detached && isCancelled(transfer, ids, sweepTokens)) {
+		if (!hasFollowers)
+			return true;
+		// The followers did not ask to stop, so only the submitter's callback is completed.
+		transfer.detached = true;
+		liveIds.erase(transfer.id);
+		cancelledCallbacks.push_back(std::move(transfer.callback));
+		transfer.callback = Callback();
+	}
+	return transfer.detached && !hasFollowers;
+}
+
+void NetworkEngine::processCancellations()
+{
+	std::vector<RequestId> ids;
+	std::vector<std::unique_ptr<Transfer>> cancelledPending;
+	std::vector<Callback> cancelledCallbacks;
+	bool sweepTokens = tokenCancelled.exchange(false);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (cancelRequests.empty() && !sweepTokens)
+			return;
+		ids.swap(cancelRequests);
+
+		for (auto &entry : followers) {
+			std::vector<Follower> &list = entry.second;
+			for (auto it = list.begin(); it != list.end();) {
+				bool cancelled = (sweepTokens && it->cancellation.isCancelled()) ||
+						 std::find(ids.begin(), ids.end(), it->id) != ids.end();
+				if (cancelled) {
+					liveIds.erase(it->id);
+					cancelledCallbacks.push_back(std::move(it->callback));
+					it = list.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		for (auto *queue : {&highQueue, &normalQueue, &lowQueue}) {
+			for (auto it = queue->begin(); it != queue->end();) {
+				if (isAbandoned(**it, ids, sweepTokens, cancelledCallbacks)) {
+					cancelledPending.push_back(std::move(*it));
+					it = queue->erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		for (auto it = deferred.begin(); it != deferred.end();) {
+			if (isAbandoned(**it, ids, sweepTokens, cancelledCallbacks)) {
+				cancelledPending.push_back(std::move(*it));
+				it = deferred.erase(it);
+			} else {
+				++it;
+			}
+		}
+
+		for (auto it = active.begin(); it != active.end();) {
+			if (isAbandoned(*it->second, ids, sweepTokens, cancelledCallbacks)) {
+				curl_multi_remove_handle(multi, it->second->handle);
+				cancelledPending.push_back(std::move(it->second));
+				it = active.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+
+	NetworkResponse cancelled;
+	cancelled.cancelled = true;
+	for (Callback &callback : cancelledCallbacks)
+		runCallback(callback, cancelled);
+	for (auto &transfer : cancelledPending)
+		finishTransfer(std::move(transfer), CURLE_OK, true);
+}
+
+void NetworkEngine::sendKeepAlives(int64_t nowMs)
+{
+	std::vector<QString> urls;
+	bool changed = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (keepAliveTargetsChanged) {
+			urls.swap(keepAliveTargets);
+			keepAliveTargetsChanged = false;
+			changed = true;
+		}
+	}
+	if (changed) {
+		std::map<std::string, KeepAlive> targets;
+		for (const QString &url : urls) {
+			std::string host = QUrl(url).host().toStdString();
+			if (host.empty() || targets.find(host) != targets.end())
+				continue;
+			auto existing = keepAlive.find(host);
+			if (existing != keepAlive.end()) {
+				targets[host] = KeepAlive{url, existing->second.lastUsedMs};
+				continue;
+			}
+			blog(LOG_INFO, "[GameDetector/NetworkEngine] Warming up connection to %s.", host.c_str());
+			targets[host] = KeepAlive{url, 0};
+		}
+		for (const auto &entry : keepAlive) {
+			if (targets.find(entry.first) == targets.end())
+				blog(LOG_INFO, "[GameDetector/NetworkEngine] Stopped keeping %s warm.",
+				     entry.first.c_str());
+		}
+		keepAlive.swap(targets);
+	}
+
+	for (auto &entry : keepAlive) {
+		KeepAlive &target = entry.second;
+		if (target.lastUsedMs > 0 && nowMs - target.lastUsedMs < KEEP_ALIVE_INTERVAL_MS)
+			continue;
+
+		// Counted from submission so the host is not probed again while this request is in flight.
+		target.lastUsedMs = nowMs;
+		NetworkRequest request;
+		request.url = target.url;
+		request.method = "HEAD";
+		request.priority = NetworkRequest::Priority::Low;
+		request.timeoutMs = KEEP_ALIVE_TIMEOUT_MS;
+		submit(request, Callback());
+		MetricsRegistry::get().incrementCounter("gamedetector_http_keepalive_requests_total");
+	}
+}
+
+void NetworkEngine::startPendingTransfers()
+{
+	int64_t now = RateLimiter::nowMs();
+
+	// Deferred transfers whose bucket should have refilled are retried first, most urgent first.
+	std::vector<std::unique_ptr<Transfer>> ready;
+	for (auto it = deferred.begin(); it != deferred.end();) {
+		if ((*it)->notBeforeMs <= now) {
+			ready.push_back(std::move(*it));
+			it = deferred.erase(it);
+		} else {
+			++it;
+		}
+	}
+	std::stable_sort(ready.begin(), ready.end(), [](const auto &a, const auto &b) {
+		return a->request.priority > b->request.priority;
+	});
+
+	size_t nextReady = 0;
+	while (active.size() < static_cast<size_t>(MAX_ACTIVE_TRANSFERS)) {
+		std::unique_ptr<Transfer> transfer;
+		if (nextReady < ready.size()) {
+			transfer = std::move(ready[nextReady++]);
+		} else {
+			std::lock_guard<std::mutex> lock(mutex);
+			for (auto *queue : {&highQueue, &normalQueue, &lowQueue}) {
+				if (!queue->empty()) {
+					transfer = std::move(queue->front());
+					queue->pop_front();
+					break;
+				}
+			}
+		}
+		if (!transfer)
+			break;
+
+		if (!admit(transfer, now))
+			continue;
+
+		if (!startTransfer(*transfer)) {
+			finishTransfer(std::move(transfer), CURLE_FAILED_INIT, false);
+			continue;
+		}
+		RequestId id = transfer->id;
+		active[id] = std::move(transfer);
+	}
+
+	// Anything not started because the engine was full waits for the next pass.
+	for (; nextReady < ready.size(); ++nextReady)
+		deferred.push_back(std::move(ready[nextReady]));
+}
+
+bool NetworkEngine::admit(std::unique_ptr<Transfer> &transfer, int64_t nowMs)
+{
+	NetworkRequest::Priority priority = transfer->request.priority;
+	double reserve = 0.0;
+	if (priority == NetworkRequest::Priority::Low)
+		reserve = LOW_PRIORITY_RESERVE;
+	else if (priority == NetworkRequest::Priority::Normal)
+		reserve = NORMAL_PRIORITY_RESERVE;
+
+	if (!circuitBreaker.allow(transfer->circuit, nowMs, &transfer->probe)) {
+		transfer->circuitOpen = true;
+		finishTransfer(std::move(transfer), CURLE_OK, false);
+		return false;
+	}
+
+	int64_t waitMs = 0;
+	if (rateLimiter.acquire(transfer->rateBucket, reserve, nowMs, &waitMs))
+		return true;
+
+	if (transfer->probe) {
+		circuitBreaker.record(transfer->circuit, CircuitBreaker::Outcome::Aborted, true, nowMs);
+		transfer->probe = false;
+	}
+
+	const char *priorityLabel = priority == NetworkRequest::Priority::High
+					    ? "high"
+					    : (priority == NetworkRequest::Priority::Low ? "low" : "normal");
+	if (priority == NetworkRequest::Priority::Low && waitMs > MAX_LOW_PRIORITY_DELAY_MS) {
+		MetricsRegistry::get().incrementCounter(
+			"gamedetector_http_throttled_requests_total",
+			MetricsRegistry::labels({{"priority", priorityLabel}, {"action", "shed"}}));
+		transfer->throttled = true;
+		finishTransfer(std::move(transfer), CURLE_OK, false);
+		return false;
+	}
+
+	MetricsRegistry::get().incrementCounter(
+		"gamedetector_http_throttled_requests_total",
+		MetricsRegistry::labels({{"priority", priorityLabel}, {"action", "deferred"}}));
+	transfer->notBeforeMs = nowMs + waitMs;
+	deferred.push_back(std::move(transfer));
+	return false;
+}
+
+long NetworkEngine::pollTimeoutMs() const
+{
+	int64_t timeoutMs = 1000;
+	int64_t now = RateLimiter::nowMs();
+	for (const auto &transfer : deferred)
+		timeoutMs = std::min(timeoutMs, std::max<int64_t>(0, transfer->notBeforeMs - now));
+	return static_cast<long>(timeoutMs);
+}
+
+bool NetworkEngine::startTransfer(Transfer &transfer)
+{
+	transfer.handle = CurlHandlePool::get().acquire(transfer.host);
+	if (!transfer.handle)
+		return false;
+
+	const NetworkRequest &request = transfer.request;
+	if (request.headerSet && request.headers.empty()) {
+		transfer.headerList = request.headerSet->list();
+	} else {
+		transfer.ownsHeaderList = true;
+		if (request.headerSet) {
+			for (const std::string &header : request.headerSet->lines())
+				transfer.headerList = curl_slist_append(transfer.headerList, header.c_str());
+		}
+		for (const std::string &header : request.headers)
+			transfer.headerList = curl_slist_append(transfer.headerList, header.c_str());
+	}
+
+	CURL *curl = transfer.handle;
+	curl_easy_setopt(curl, CURLOPT_URL, request.url.toStdString().c_str());
+	curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer.headerList);
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &NetworkEngine::writeCallback);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
+	curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, &NetworkEngine::headerCallback);
+	curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer);
+	curl_easy_setopt(curl, CURLOPT_PRIVATE, &transfer);
+	curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+	curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, &NetworkEngine::progressCallback);
+	curl_easy_setopt(curl, CURLOPT_XFERINFODATA, this);
+	curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
+	curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+	curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+	curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);
+	curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, request.timeoutMs);
+	curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+	// Wait for a connection that is still being set up to confirm HTTP/2 rather than opening another.
+	curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+	// An empty string offers every encoding this libcurl build can decode (gzip, and brotli if built).
+	curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+
+	if (request.verbose) {
+		curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
+	}
+
+	if (request.method == "POST") {
+		curl_easy_setopt(curl, CURLOPT_POST, 1L);
+		curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+		curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.constData());
+	} else if (request.method == "HEAD") {
+		curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+	} else if (request.method != "GET") {
+		curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, request.method.toStdString().c_str());
+		if (!request.body.isEmpty()) {
+			curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+			curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.constData());
+		}
+	}
+
+	transfer.startUs = Tracer::nowUs();
+	if (curl_multi_add_handle(multi, curl) != CURLM_OK) {
+		if (transfer.ownsHeaderList)
+			curl_slist_free_all(transfer.headerList);
+		transfer.headerList = nullptr;
+		CurlHandlePool::get().release(transfer.host, curl);
+		transfer.handle = nullptr;
+		return false;
+	}
+	return true;
+}
+
+static bool is_transient_error(CURLcode result)
+{
+	switch (result) {
+	case CURLE_COULDNT_RESOLVE_HOST:
+	case CURLE_COULDNT_CONNECT:
+	case CURLE_OPERATION_TIMEDOUT:
+	case CURLE_SSL_CONNECT_ERROR:
+	case CURLE_SEND_ERROR:
+	case CURLE_RECV_ERROR:
+	case CURLE_GOT_NOTHING:
+	case CURLE_PARTIAL_FILE:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static const char *protocol_label(long httpVersion)
+{
+	switch (httpVersion) {
+	case CURL_HTTP_VERSION_1_0:
+		return "http/1.0";
+	case CURL_HTTP_VERSION_1_1:
+		return "http/1.1";
+	case CURL_HTTP_VERSION_2_0:
+		return "http/2";
+#ifdef CURL_HTTP_VERSION_3
+	case CURL_HTTP_VERSION_3:
+		return "http/3";
+#endif
+	default:
+		return "unknown";
+	}
+}
+
+static bool is_server_failure(long httpCode)
+{
+	return httpCode >= 500 && httpCode <= 599;
+}
+
+void NetworkEngine::finishTransfer(std::unique_ptr<Transfer> transfer, CURLcode result, bool cancelled)
+{
+	NetworkResponse response;
+	response.error = result;
+	response.cancelled = cancelled;
+	response.throttled = transfer->throttled;
+	response.circuitOpen = transfer->circuitOpen;
+	if (transfer->throttled)
+		response.httpCode = 429;
+	else if (transfer->circuitOpen)
+		response.httpCode = 503;
+
+	bool sent = transfer->handle != nullptr;
+	long httpVersion = 0;
+	curl_off_t wireBytes = 0;
+	if (sent) {
+		auto target = keepAlive.find(transfer->host);
+		if (target != keepAlive.end())
+			target->second.lastUsedMs = RateLimiter::nowMs();
+	}
+	if (transfer->handle) {
+		if (!cancelled) {
+			curl_easy_getinfo(transfer->handle, CURLINFO_RESPONSE_CODE, &response.httpCode);
+			curl_easy_getinfo(transfer->handle, CURLINFO_HTTP_VERSION, &httpVersion);
+			// Body bytes as received, before content decoding.
+			curl_easy_getinfo(transfer->handle, CURLINFO_SIZE_DOWNLOAD_T, &wireBytes);
+		}
+		CurlHandlePool::get().release(transfer->host, transfer->handle);
+		transfer->handle = nullptr;
+	}
+	if (transfer->headerList) {
+		if (transfer->ownsHeaderList)
+			curl_slist_free_all(transfer->headerList);
+		transfer->headerList = nullptr;
+		transfer->ownsHeaderList = false;
+	}
+
+	const NetworkRequest &request = transfer->request;
+	if (transfer->startUs >= 0) {
+		int64_t durationUs = Tracer::nowUs() - transfer->startUs;
+		if (Tracer::get().isEnabled()) {
+			QByteArray detail = (request.method + " " + request.url).toUtf8();
+			Tracer::get().record("NetworkEngine/request", "network", transfer->startUs, durationUs,
+					     detail.constData());
+		}
+
+		QString endpoint;
+		if (request.endpoint) {
+			endpoint = QString::fromUtf8(request.endpoint);
+		} else {
+			QUrl parsedUrl(request.url);
+			endpoint = parsedUrl.host() + parsedUrl.path();
+		}
+		QString status = cancelled ? QString("cancelled")
+					   : (result == CURLE_OK ? QString::number(response.httpCode) : QString("error"));
+		MetricsRegistry::get().observe("gamedetector_http_request_duration_seconds", durationUs / 1e6,
+					       MetricsRegistry::labels({{"endpoint", endpoint}, {"method", request.method}}));
+		MetricsRegistry::get().incrementCounter(
+			"gamedetector_http_requests_total",
+			MetricsRegistry::labels({{"endpoint", endpoint}, {"method", request.method}, {"status", status}}));
+
+		if (!cancelled && result == CURLE_OK) {
+			QString protocol = protocol_label(httpVersion);
+			MetricsRegistry::get().incrementCounter(
+				"gamedetector_http_response_bytes_total",
+				MetricsRegistry::labels({{"endpoint", endpoint}, {"protocol", protocol}}),
+				static_cast<double>(wireBytes));
+			qint64 savedBytes = static_cast<qint64>(transfer->response.size()) - static_cast<qint64>(wireBytes);
+			if (savedBytes > 0) {
+				MetricsRegistry::get().incrementCounter("gamedetector_http_compression_saved_bytes_total",
+									MetricsRegistry::labels({{"endpoint", endpoint}}),
+									static_cast<double>(savedBytes));
+			}
+		}
+	}
+
+	if (!cancelled && result != CURLE_OK) {
+		blog(LOG_ERROR, "[GameDetector/NetworkEngine] cURL error: %s", curl_easy_strerror(result));
+	} else if (!cancelled && sent) {
+		response.body = std::move(transfer->response);
+		response.headers = std::move(transfer->responseHeaders);
+		rateLimiter.update(transfer->rateBucket, response.httpCode, response.headers, RateLimiter::nowMs());
+	}
+
+	if (sent || transfer->probe) {
+		CircuitBreaker::Outcome outcome = CircuitBreaker::Outcome::Success;
+		if (cancelled || !sent)
+			outcome = CircuitBreaker::Outcome::Aborted;
+		else if (result != CURLE_OK || is_server_failure(response.httpCode))
+			outcome = CircuitBreaker::Outcome::Failure;
+		circuitBreaker.record(transfer->circuit, outcome, transfer->probe, RateLimiter::nowMs());
+		transfer->probe = false;
+	}
+
+	if (scheduleRetry(transfer, response))
+		return;
+
+	std::vector<Callback> waiting;
+	waiting.push_back(std::move(transfer->callback));
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		liveIds.erase(transfer->id);
+		if (!transfer->flightKey.empty()) {
+			flights.erase(transfer->flightKey);
+			auto it = followers.find(transfer->id);
+			if (it != followers.end()) {
+				for (Follower &follower : it->second) {
+					liveIds.erase(follower.id);
+					waiting.push_back(std::move(follower.callback));
+				}
+				followers.erase(it);
+			}
+		}
+	}
+
+	for (Callback &callback : waiting)
+		runCallback(callback, response);
+}
+
+void NetworkEngine::runCallback(const Callback &callback, const NetworkResponse &response)
+{
+	if (!callback)
+		return;
+	try {
+		callback(response);
+	} catch (const std::exception &e) {
+		blog(LOG_ERROR, "[GameDetector/NetworkEngine] Exception caught in completion callback: %s", e.what());
+	} catch (...) {
+		blog(LOG_ERROR, "[GameDetector/NetworkEngine] Unknown exception caught in completion callback.");
+	}
+}
+
+bool NetworkEngine::scheduleRetry(std::unique_ptr<Transfer> &transfer, const NetworkResponse &response)
+{
+	if (!running || response.cancelled || response.throttled || response.circuitOpen ||
+	    transfer->attempt >= MAX_ATTEMPTS)
+		return false;
+
+	const NetworkRequest &request = transfer->request;
+	bool idempotent = request.idempotent || request.method == "GET" || request.method == "HEAD" ||
+			  request.method == "PUT" || request.method == "DELETE";
+	bool transient = response.error != CURLE_OK
+				 ? is_transient_error(response.error)
+				 : (response.httpCode == 429 || is_server_failure(response.httpCode));
+	if (!idempotent || !transient)
+		return false;
+
+	// Exponential backoff with equal jitter: half the delay is fixed, the other half random.
+	int64_t backoffMs = RETRY_BASE_DELAY_MS << (transfer->attempt - 1);
+	int64_t jitterMs = QRandomGenerator::global()->bounded(static_cast<quint32>(backoffMs / 2 + 1));
+	int64_t delayMs = backoffMs / 2 + jitterMs;
+
+	auto retryAfter = response.headers.find("retry-after");
+	if (retryAfter != response.headers.end()) {
+		int64_t requestedMs = std::atoll(retryAfter->second.c_str()) * 1000;
+		if (requestedMs > MAX_RETRY_DELAY_MS)
+			return false;
+		delayMs = std::max(delayMs, requestedMs);
+	}
+
+	blog(LOG_INFO, "[GameDetector/NetworkEngine] Retrying %s %s in %lld ms (attempt %d of %d).",
+	     request.method.toStdString().c_str(), request.url.toStdString().c_str(), static_cast<long long>(delayMs),
+	     transfer->attempt + 1, MAX_ATTEMPTS);
+	MetricsRegistry::get().incrementCounter("gamedetector_http_retries_total");
+
+	transfer->attempt++;
+	transfer->response.clear();
+	transfer->responseHeaders.clear();
+	transfer->startUs = -1;
+	transfer->notBeforeMs = RateLimiter::nowMs() + delayMs;
+	deferred.push_back(std::move(transfer));
+	return true;
+}
+
+void NetworkEngine::failAll()
+{
+	for (auto &entry : active) {
+#if LIBCURL_VERSION_NUM >= 0x075700
+		// Do not wait for a DNS lookup thread that is still blocked in the resolver.
+		curl_easy_setopt(entry.second->handle, CURLOPT_QUICK_EXIT, 1L);
+#endif
+		curl_multi_remove_handle(multi, entry.second->handle);
+		finishTransfer(std::move(entry.second), CURLE_OK, true);
+	}
+	active.clear();
+
+	std::vector<std::unique_ptr<Transfer>> pending;
+	for (auto &transfer : deferred)
+		pending.push_back(std::move(transfer));
+	deferred.clear();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto *queue : {&highQueue, &normalQueue, &lowQueue}) {
+			for (auto &transfer : *queue)
+				pending.push_back(std::move(transfer));
+			queue->clear();
+		}
+		cancelRequests.clear();
+	}
+
+	for (auto &transfer : pending)
+		finishTransfer(std::move(transfer), CURLE_OK, true);
+}
@@ -0,0 +1,280 @@
+#ifndef NETWORKENGINE_H
+#define NETWORKENGINE_H
+
+#pragma once
+
+#include <curl/curl.h>
+#include <obs-module.h>
+
+#include "CircuitBreaker.h"
+#include "RateLimiter.h"
+#include "RequestTemplate.h"
+
+#include <QFuture>
+#include <QByteArray>
+#include <QFutureInterface>
+#include <QString>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Shared flag that aborts every request it is attached to. Copies share the same state; a
+// default-constructed token is never cancelled. Cancel it through NetworkEngine::cancel() so the
+// reactor removes the affected transfers right away.
+class CancellationToken {
+public:
+	static CancellationToken create() { return CancellationToken(std::make_shared<std::atomic<bool>>(false)); }
+	CancellationToken() = default;
+
+	bool isCancelled() const { return flag && flag->load(std::memory_order_relaxed); }
+	bool isValid() const { return flag != nullptr; }
+
+private:
+	friend class NetworkEngine;
+	explicit CancellationToken(std::shared_ptr<std::atomic<bool>> flag) : flag(std::move(flag)) {}
+
+	std::shared_ptr<std::atomic<bool>> flag;
+};
+
+struct NetworkRequest {
+	enum class Priority { Low, Normal, High };
+
+	QString url;
+	QString method = "GET";
+	// Name from the ApiEndpoints table, used as the metrics label. Host and path are used when unset.
+	const char *endpoint = nullptr;
+	// Circuit breaker the request counts against. The URL's host when unset; platforms name their
+	// own so they still get one each when they share a host, as the stand-ins on 127.0.0.1 do.
+	std::string circuit;
+	// Prebuilt headers shared with other requests, sent ahead of any per-request headers.
+	HeaderSetPtr headerSet;
+	std::vector<std::string> headers;
+	// Implicitly shared, so a serialized JSON body reaches curl without another copy.
+	QByteArray body;
+	Priority priority = Priority::Normal;
+	long timeoutMs = 30000;
+	bool verbose = false;
+	// Identical GETs (same URL, headers, priority and timeout) that overlap share one transfer.
+	// Each caller keeps its own id and cancellation token.
+	bool coalesce = true;
+	// GET, HEAD, PUT and DELETE are always retried on transient failures. Set this for other
+	// methods that are safe to repeat, such as a PATCH that writes absolute values.
+	bool idempotent = false;
+	CancellationToken cancellation;
+};
+
+struct NetworkResponse {
+	long httpCode = 0;
+	// The receive buffer itself, handed over without conversion. Parse it with
+	// QJsonDocument::fromJson directly rather than going through QString.
+	QByteArray body;
+	CURLcode error = CURLE_OK;
+	bool cancelled = false;
+	// Not sent because the platform's rate-limit budget was reserved for higher priority work.
+	// httpCode is set to 429 so callers treat it like a rejection from the server.
+	bool throttled = false;
+	// Not sent because the host's circuit breaker is open. httpCode is set to 503.
+	bool circuitOpen = false;
+	// Response headers with lowercase names. Repeated headers keep the last value.
+	std::map<std::string, std::string> headers;
+
+	bool isSuccess() const { return error == CURLE_OK && !cancelled && httpCode >= 200 && httpCode < 300; }
+};
+
+// Runs every HTTP transfer of the plugin on a single curl_multi reactor thread. Callers get
+// a QFuture or a completion callback instead of blocking a pool thread for the whole request.
+// Completion callbacks run on the reactor thread and must not block or wait on other requests.
+// Requests to the same host are multiplexed over one HTTP/2 connection when the server supports it,
+// and responses are requested compressed.
+//
+// Transfers are admitted through a RateLimiter bucket per host and token. When a bucket runs low,
+// Low priority requests are shed or delayed first and Normal ones next, while High priority
+// requests may use the budget down to the last token.
+//
+// Idempotent requests that fail with a transport error, 429 or 5xx are retried up to MAX_ATTEMPTS
+// times with jittered exponential backoff, honouring Retry-After. A CircuitBreaker per host, or per
+// circuit the request names, stops sending once it keeps failing.
+class NetworkEngine {
+public:
+	using RequestId = uint64_t;
+	using Callback = std::function<void(const NetworkResponse &)>;
+
+	static NetworkEngine &get();
+
+	RequestId submit(const NetworkRequest &request, Callback callback);
+	QFuture<NetworkResponse> submit(const NetworkRequest &request, RequestId *id = nullptr);
+
+	// Runs the response through map on the reactor thread and reports its result.
+	template<typename T, typename Func>
+	QFuture<T> submitMapped(const NetworkRequest &request, const char *context, Func &&map);
+
+	// Completes the request with cancelled = true. Returns false once it has already finished.
+	// A request merged by single-flight is cancelled on its own; the shared transfer is only
+	// aborted once nobody waits for it.
+	bool cancel(RequestId id);
+	// Cancels the token and completes every queued or running request that carries it.
+	void cancel(const CancellationToken &token);
+	// Resolves and connects to each URL's host now, so the first real request skips DNS, TCP and
+	// TLS setup. The connections are then kept open with a HEAD request whenever the host has been
+	// idle for KEEP_ALIVE_INTERVAL_MS. Replaces the previous targets: hosts no longer listed stop
+	// being probed, and an empty list stops the keep-alives altogether.
+	void setKeepAliveTargets(const std::vector<QString> &urls);
+	// Aborts all I/O and joins the reactor. In-flight requests complete with cancelled = true
+	// before this returns; transfers stop at their next progress callback, so this stays within
+	// SHUTDOWN_BUDGET_MS as long as completion callbacks keep to the no-blocking rule.
+	void shutdown();
+
+	// Reports circuit breaker state changes. Called on the reactor thread.
+	void setCircuitListener(CircuitBreaker::Listener listener);
+
+	static constexpr int MAX_ACTIVE_TRANSFERS = 256;
+	static constexpr long MAX_CONNECTIONS_PER_HOST = 8;
+	// Fraction of a bucket each priority must leave untouched.
+	static constexpr double LOW_PRIORITY_RESERVE = 0.5;
+	static constexpr double NORMAL_PRIORITY_RESERVE = 0.1;
+	// Low priority requests that would wait longer than this are shed instead of delayed.
+	static constexpr int64_t MAX_LOW_PRIORITY_DELAY_MS = 10000;
+	static constexpr int MAX_ATTEMPTS = 3;
+	static constexpr int64_t RETRY_BASE_DELAY_MS = 500;
+	// Failures asking to wait longer than this (through Retry-After) are reported, not retried.
+	static constexpr int64_t MAX_RETRY_DELAY_MS = 30000;
+	// Larger Content-Length values are not trusted for preallocation.
+	static constexpr long long MAX_PREALLOCATED_BODY = 16 * 1024 * 1024;
+	static constexpr int64_t SHUTDOWN_BUDGET_MS = 100;
+	// Below libcurl's default maximum idle age of 118 seconds, so warm connections are not dropped.
+	static constexpr int64_t KEEP_ALIVE_INTERVAL_MS = 45000;
+	static constexpr long KEEP_ALIVE_TIMEOUT_MS = 5000;
+
+private:
+	NetworkEngine();
+	~NetworkEngine();
+
+	struct Transfer {
+		RequestId id = 0;
+		NetworkRequest request;
+		Callback callback;
+		std::string host;
+		std::string circuit;
+		std::string flightKey;
+		CURL *handle = nullptr;
+		// Owned only when the request adds headers to its header set; otherwise it points into
+		// the shared HeaderSet and must not be freed.
+		struct curl_slist *headerList = nullptr;
+		bool ownsHeaderList = false;
+		QByteArray response;
+		std::map<std::string, std::string> responseHeaders;
+		std::string rateBucket;
+		int64_t notBeforeMs = 0;
+		int attempt = 1;
+		bool throttled = false;
+		bool circuitOpen = false;
+		bool probe = false;
+		int64_t startUs = -1;
+		// The submitting request was cancelled while followers still wait; callback is already
+		// completed and the transfer runs on for them.
+		bool detached = false;
+	};
+	// A request that joined another's transfer through single-flight.
+	struct Follower {
+		RequestId id = 0;
+		Callback callback;
+		CancellationToken cancellation;
+	};
+
+	static size_t writeCallback(void *contents, size_t size, size_t nmemb, void *userp);
+	static size_t headerCallback(char *buffer, size_t size, size_t nitems, void *userdata);
+	static int progressCallback(void *clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal,
+				    curl_off_t ulnow);
+
+	void run();
+	void startPendingTransfers();
+	bool admit(std::unique_ptr<Transfer> &transfer, int64_t nowMs);
+	long pollTimeoutMs() const;
+	void processCancellations();
+	bool isCancelled(const Transfer &transfer, const std::vector<RequestId> &ids, bool sweepTokens) const;
+	bool isAbandoned(Transfer &transfer, const std::vector<RequestId> &ids, bool sweepTokens,
+			 std::vector<Callback> &cancelledCallbacks);
+	void finishTransfer(std::unique_ptr<Transfer> transfer, CURLcode result, bool cancelled);
+	static void runCallback(const Callback &callback, const NetworkResponse &response);
+	bool startTransfer(Transfer &transfer);
+	bool scheduleRetry(std::unique_ptr<Transfer> &transfer, const NetworkResponse &response);
+	void failAll();
+	void sendKeepAlives(int64_t nowMs);
+
+	std::deque<std::unique_ptr<Transfer>> &queueFor(NetworkRequest::Priority priority);
+	static std::string flightKeyFor(const NetworkRequest &request);
+	static std::string rateBucketFor(const NetworkRequest &request, const std::string &host);
+
+	CURLM *multi = nullptr;
+	std::thread reactor;
+	std::atomic<bool> running{false};
+	std::atomic<RequestId> nextId{1};
+
+	std::mutex mutex;
+	std::deque<std::unique_ptr<Transfer>> highQueue;
+	std::deque<std::unique_ptr<Transfer>> normalQueue;
+	std::deque<std::unique_ptr<Transfer>> lowQueue;
+	std::vector<RequestId> cancelRequests;
+	std::atomic<bool> tokenCancelled{false};
+	std::set<RequestId> liveIds;
+	std::map<std::string, RequestId> flights;
+	std::map<RequestId, std::vector<Follower>> followers;
+	std::vector<QString> keepAliveTargets;
+	bool keepAliveTargetsChanged = false;
+	bool shuttingDown = false;
+
+	// Owned by the reactor thread only.
+	struct KeepAlive {
+		QString url;
+		int64_t lastUsedMs = 0;
+	};
+	std::map<std::string, KeepAlive> keepAlive;
+	std::map<RequestId, std::unique_ptr<Transfer>> active;
+	std::vector<std::unique_ptr<Transfer>> deferred;
+	RateLimiter rateLimiter;
+	CircuitBreaker circuitBreaker;
+	size_t reportedActive = 0;
+};
+
+template<typename T> QFuture<T> MakeReadyFuture(const T &value)
+{
+	QFutureInterface<T> promise;
+	promise.reportStarted();
+	promise.reportResult(value);
+	promise.reportFinished();
+	return promise.future();
+}
+
+template<typename T, typename Func>
+QFuture<T> NetworkEngine::submitMapped(const NetworkRequest &request, const char *context, Func &&map)
+{
+	auto promise = std::make_shared<QFutureInterface<T>>();
+	promise->reportStarted();
+	QFuture<T> future = promise->future();
+
+	submit(request, [promise, context, map = std::forward<Func>(map)](const NetworkResponse &response) mutable {
+		T result{};
+		try {
+			result = map(response);
+		} catch (const std::exception &e) {
+			blog(LOG_ERROR, "[%s] Exception caught: %s", context, e.what());
+		} catch (...) {
+			blog(LOG_ERROR, "[%s] Unknown exception caught.", context);
+		}
+		promise->reportResult(result);
+		promise->reportFinished();
+	});
+	return future;
+}
+
+#endif // NETWORKENGINE_H
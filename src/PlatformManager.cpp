@@ -5,6 +5,10 @@
 #include "IPlatformService.h"
 #include "ConfigManager.h"
 #include "GameDetector.h"
+#include "Tracer.h"
+#include "MetricsRegistry.h"
+#include "NetworkEngine.h"
+#include "MockPlatformService.h"
 
 #include <QtConcurrent/QtConcurrent>
 #include <QJsonDocument>
@@ -13,55 +17,133 @@
 
 #include <QTimer>
 #include <QDebug>
-#include <QVariant>
 
-PlatformManager::PlatformManager()
+#include <algorithm>
+
+PlatformManager::PlatformManager() : updateIntents("pending_updates.json")
 {
 	lastSetCategoryName = "Just Chatting";
 
-	TwitchServiceAdapter *twitch = new TwitchServiceAdapter(this);
-	TrovoAuthManager *trovo = new TrovoAuthManager(this);
+	registerService(new TwitchServiceAdapter(this));
+	registerService(new TrovoAuthManager(this));
+	if (ConfigManager::get().getMockPlatformEnabled())
+		registerService(new MockPlatformService(this));
 
-	auto forwardSignal = [this](bool success, QString gameName, QString error) {
-		emit categoryUpdateFinished(success, gameName, error);
-	};
-	connect(twitch, &IPlatformService::categoryUpdateFinished, this, forwardSignal);
-	connect(trovo, &IPlatformService::categoryUpdateFinished, this, forwardSignal);
+	reconcileTimer = new QTimer(this);
+	reconcileTimer->setInterval(RECONCILE_INTERVAL_MS);
+	connect(reconcileTimer, &QTimer::timeout, this, &PlatformManager::reconcilePendingUpdates);
+	if (!updateIntents.isEmpty())
+		reconcileTimer->start();
 
 	gameIdWatcher = new QFutureWatcher<QString>(this);
 	categoryUpdateWatcher = new QFutureWatcher<void *>(this);
 	chatMessageWatcher = new QFutureWatcher<bool>(this);
 
-	categoryFetchWatcher = new QFutureWatcher<QHash<QString, QString>>(this);
-	connect(categoryFetchWatcher, &QFutureWatcher<QHash<QString, QString>>::finished, this,
-		[this]() { emit categoriesFetched(categoryFetchWatcher->result()); });
+	categoryFetchDeadline = new QTimer(this);
+	categoryFetchDeadline->setSingleShot(true);
+	connect(categoryFetchDeadline, &QTimer::timeout, this, [this]() {
+		QHash<QString, QString> results;
+		for (const QString &platform : pendingCategoryFetches) {
+			blog(LOG_WARNING, "[GameDetector/PlatformManager] %s channel info did not arrive within %d ms.",
+			     platform.toStdString().c_str(), CATEGORY_FETCH_DEADLINE_MS);
+			results[platform] = "Erro: Timeout";
+		}
+		pendingCategoryFetches.clear();
+		if (!results.isEmpty())
+			emit categoriesFetched(results);
+	});
 
-	cooldownTimer = new QTimer(this);
-	cooldownTimer->setSingleShot(true);
-	connect(cooldownTimer, &QTimer::timeout, [this]() {
-		onCooldown = false;
-		emit cooldownFinished();
+	NetworkEngine::get().setCircuitListener([this](const std::string &key, CircuitBreaker::State state) {
+		// Called on the reactor thread; the registry is only read on the main thread. Platform
+		// requests name their circuit with ApiEndpoints::circuit, so the key starts with the platform.
+		QString circuit = QString::fromStdString(key);
+		QMetaObject::invokeMethod(
+			this,
+			[this, circuit, state]() {
+				for (auto it = pipelines.cbegin(); it != pipelines.cend(); ++it) {
+					if (!it.value().service || !circuit.startsWith(it.key() + '/'))
+						continue;
+					emit platformHealthChanged(it.key(), state);
+					// The platform answers again, so whatever was lost while it was down can be
+					// sent now.
+					if (state == CircuitBreaker::State::Closed)
+						reconcile(it.key());
+				}
+			},
+			Qt::QueuedConnection);
 	});
+
+	connect(&GameDetector::get(), &GameDetector::gameListLoaded, this,
+		[](const QStringList &gameNames) { TwitchAuthManager::get().prewarmGameIds(gameNames); });
 }
 
 PlatformManager::~PlatformManager()
 {
-	if (cooldownTimer->isActive()) {
-		cooldownTimer->stop();
+	for (Pipeline &pipeline : pipelines) {
+		if (pipeline.cooldownTimer->isActive())
+			pipeline.cooldownTimer->stop();
 	}
 }
 
+bool PlatformManager::registerService(IPlatformService *service)
+{
+	if (!service)
+		return false;
+
+	QString platform = service->platformId();
+	if (platform.isEmpty() || pipelines.contains(platform)) {
+		blog(LOG_WARNING, "[GameDetector/PlatformManager] Ignoring platform service with duplicate id '%s'.",
+		     platform.toStdString().c_str());
+		service->deleteLater();
+		return false;
+	}
+	service->setParent(this);
+
+	Pipeline pipeline;
+	pipeline.service = service;
+	pipeline.cooldownTimer = new QTimer(this);
+	pipeline.cooldownTimer->setSingleShot(true);
+	connect(pipeline.cooldownTimer, &QTimer::timeout, this, [this, platform]() { onCooldownExpired(platform); });
+	connect(service, &IPlatformService::categoryUpdateFinished, this,
+		[this, platform](bool success, QString gameName, QString message) {
+			onServiceUpdateFinished(platform, success, gameName, message);
+		});
+	connect(service, &IPlatformService::categoryUpdateFinished, this,
+		[this](bool success, QString gameName, QString error) {
+			emit categoryUpdateFinished(success, gameName, error);
+		});
+	pipelines.insert(platform, pipeline);
+
+	blog(LOG_INFO, "[GameDetector/PlatformManager] Registered platform %s (capabilities 0x%x).",
+	     platform.toStdString().c_str(), service->capabilities());
+	return true;
+}
+
+QStringList PlatformManager::registeredPlatforms() const
+{
+	return pipelines.keys();
+}
+
 void PlatformManager::shutdown()
 {
 	shuttingDown = true;
-
-	if (cooldownTimer && cooldownTimer->isActive()) {
-		cooldownTimer->stop();
+	NetworkEngine::get().setCircuitListener(nullptr);
+
+	for (Pipeline &pipeline : pipelines) {
+		if (pipeline.service)
+			pipeline.service->shutdown();
+		pipeline.cooldownTimer->stop();
+		pipeline.pending = PendingUpdate();
+		pipeline.pendingChatMessage.clear();
+	}
+	if (reconcileTimer) {
+		reconcileTimer->stop();
 	}
 
-	if (categoryFetchWatcher && categoryFetchWatcher->isRunning()) {
-		categoryFetchWatcher->cancel();
-		categoryFetchWatcher->waitForFinished();
+	categoryFetchGeneration++;
+	pendingCategoryFetches.clear();
+	if (categoryFetchDeadline && categoryFetchDeadline->isActive()) {
+		categoryFetchDeadline->stop();
 	}
 
 	if (gameIdWatcher && gameIdWatcher->isRunning()) {
@@ -79,69 +161,194 @@ void PlatformManager::shutdown()
 		categoryUpdateWatcher->waitForFinished();
 	}
 
-	auto services = findChildren<IPlatformService *>();
-	qDeleteAll(services);
+	for (Pipeline &pipeline : pipelines)
+		delete pipeline.service.data();
 }
 
-bool PlatformManager::sendChatMessage(const QString &message)
+bool PlatformManager::sendChatMessage(const QString &message, const QStringList &platforms)
 {
-	if (onCooldown) {
-		blog(LOG_INFO, "[GameDetector/PlatformManager] Action is on cooldown. Ignoring new request.");
-		return false;
+	bool accepted = false;
+	for (auto it = pipelines.begin(); it != pipelines.end(); ++it) {
+		Pipeline &pipeline = it.value();
+		if (!pipeline.service || !pipeline.service->hasCapability(IPlatformService::SendChat) ||
+		    (!platforms.isEmpty() && !platforms.contains(it.key())))
+			continue;
+		accepted = true;
+		if (pipeline.onCooldown) {
+			blog(LOG_INFO, "[GameDetector/PlatformManager] %s is on cooldown. Message will be sent when it ends.",
+			     it.key().toStdString().c_str());
+			MetricsRegistry::get().incrementCounter(
+				"gamedetector_cooldown_coalesced_total",
+				MetricsRegistry::labels({{"action", "chat_message"}, {"platform", it.key()}}));
+			pipeline.pendingChatMessage = message;
+			continue;
+		}
+		pipeline.service->sendChatMessage(message);
 	}
+	return accepted;
+}
 
-	auto services = findChildren<IPlatformService *>();
-	for (auto service : services) {
-		service->sendChatMessage(message);
+PlatformManager::UpdateResult PlatformManager::updateCategory(const QString &gameName, const QString &title,
+							      bool force, const QStringList &platforms)
+{
+	TraceSpan span("PlatformManager::updateCategory", "platform");
+
+	QString pendingBefore = getPendingCategory();
+	bool upToDate = false;
+	bool queued = false;
+	bool dispatched = false;
+	for (auto it = pipelines.begin(); it != pipelines.end(); ++it) {
+		const QString &platform = it.key();
+		Pipeline &pipeline = it.value();
+		if (!pipeline.service || !pipeline.service->hasCapability(IPlatformService::UpdateCategory) ||
+		    (!platforms.isEmpty() && !platforms.contains(platform)))
+			continue;
+		// A platform that cannot set titles is compared and updated on the category alone.
+		QString platformTitle =
+			pipeline.service->hasCapability(IPlatformService::UpdateTitle) ? title : QString();
+
+		if (!force && !pipeline.service->isAuthenticated())
+			continue;
+		if (!isOutdated(platform, gameName, platformTitle, force)) {
+			// Whatever was queued before is superseded by a state the platform already has.
+			pipeline.pending = PendingUpdate();
+			upToDate = true;
+			continue;
+		}
+
+		PendingUpdate update{true, gameName, platformTitle, force};
+		if (pipeline.onCooldown || pipeline.inFlight) {
+			if (!pipeline.pending.active || pipeline.pending.gameName != gameName) {
+				blog(LOG_INFO, "[GameDetector/PlatformManager] %s is busy. Queued: %s",
+				     platform.toStdString().c_str(), gameName.toStdString().c_str());
+				MetricsRegistry::get().incrementCounter(
+					"gamedetector_cooldown_coalesced_total",
+					MetricsRegistry::labels({{"action", "update_category"}, {"platform", platform}}));
+			}
+			pipeline.pending = update;
+			queued = true;
+			continue;
+		}
+
+		if (!dispatched) {
+			blog(LOG_INFO, "[GameDetector/PlatformManager] Changing category to: %s",
+			     gameName.toStdString().c_str());
+			span.setDetail(gameName);
+			dispatched = true;
+		}
+		dispatchUpdate(platform, update, true);
 	}
 
-	return true;
+	if (getPendingCategory() != pendingBefore)
+		emit pendingUpdateChanged(getPendingCategory());
+	if (dispatched)
+		return UpdateResult::Sent;
+	if (queued)
+		return UpdateResult::Queued;
+	return upToDate ? UpdateResult::UpToDate : UpdateResult::Unavailable;
 }
 
-bool PlatformManager::updateCategory(const QString &gameName, const QString &title, bool force)
+bool PlatformManager::isOutdated(const QString &platform, const QString &gameName, const QString &title, bool force)
 {
-	if (isOnCooldown()) {
-		blog(LOG_INFO, "[GameDetector/PlatformManager] Action is on cooldown. Ignoring new request.");
+	// Only platforms that are not already showing, or about to show, the requested state are
+	// called. A forced update is sent unless the channel was just read back with that state.
+	IPlatformService *service = serviceFor(platform);
+	if (!service)
+		return false;
+	if (isObserved(platform, gameName, title)) {
+		updateIntents.drop(platform);
 		return false;
 	}
+	if (force)
+		return true;
+	if (!service->isAuthenticated())
+		return false;
 
-	if (!force && getLastSetCategory() == gameName) {
+	if (stateMatches(confirmedRequests.value(platform), gameName, title))
 		return false;
-	}
+	UpdateIntentQueue::Intent intent;
+	return !updateIntents.pending(platform, &intent) ||
+	       !stateMatches({intent.category, intent.title, true}, gameName, title);
+}
 
-	QStringList targetPlatforms = this->property("targetPlatforms").toStringList();
-	this->setProperty("targetPlatforms", QVariant());
+void PlatformManager::dispatchUpdate(const QString &platform, const PendingUpdate &update, bool recordIntent)
+{
+	Pipeline &pipeline = pipelines[platform];
+	if (recordIntent && pipeline.service->isAuthenticated())
+		updateIntents.record(platform, update.gameName, update.title);
+
+	// Set before the call: a service may report its result synchronously.
+	pipeline.inFlight = true;
+	pipeline.inFlightUpdate = update;
+	pipeline.updateStartedUs = Tracer::get().isEnabled() ? Tracer::nowUs() : -1;
+	startCooldown(platform);
+	pipeline.service->updateCategory(update.gameName, update.title);
+}
 
-	blog(LOG_INFO, "[GameDetector/PlatformManager] Changing category to: %s", gameName.toStdString().c_str());
+void PlatformManager::startCooldown(const QString &platform)
+{
+	int delaySeconds = ConfigManager::get().getActionDelay();
+	if (delaySeconds <= 0)
+		return;
 
-	auto services = findChildren<IPlatformService *>();
-	for (auto service : services) {
-		bool shouldUpdate = true;
-		if (!targetPlatforms.isEmpty()) {
-			shouldUpdate = false;
-			if (qobject_cast<TwitchServiceAdapter *>(service) && targetPlatforms.contains("Twitch"))
-				shouldUpdate = true;
-			else if (qobject_cast<TrovoAuthManager *>(service) && targetPlatforms.contains("Trovo"))
-				shouldUpdate = true;
-		}
+	Pipeline &pipeline = pipelines[platform];
+	pipeline.onCooldown = true;
+	pipeline.cooldownTimer->start(delaySeconds * 1000);
+	emit cooldownStarted(getCooldownRemaining());
+}
 
-		if (shouldUpdate) {
-			service->updateCategory(gameName, title);
-		}
-	}
+void PlatformManager::onCooldownExpired(const QString &platform)
+{
+	pipelines[platform].onCooldown = false;
+	runPending(platform);
+	// Running a queued update may have started the next cooldown already.
+	if (!isOnCooldown())
+		emit cooldownFinished();
+}
 
-	setLastSetCategory(gameName);
-	setCooldown();
+void PlatformManager::runPending(const QString &platform)
+{
+	if (shuttingDown)
+		return;
 
-	QTimer::singleShot(3000, this, [this]() { fetchCurrentCategories(true); });
+	Pipeline &pipeline = pipelines[platform];
+	if (!pipeline.service || pipeline.onCooldown || pipeline.inFlight)
+		return;
 
-	return true;
+	if (!pipeline.pendingChatMessage.isEmpty()) {
+		QString message = pipeline.pendingChatMessage;
+		pipeline.pendingChatMessage.clear();
+		pipeline.service->sendChatMessage(message);
+	}
+
+	if (pipeline.pending.active) {
+		QString pendingBefore = getPendingCategory();
+		PendingUpdate update = pipeline.pending;
+		pipeline.pending = PendingUpdate();
+		if (isOutdated(platform, update.gameName, update.title, update.force))
+			dispatchUpdate(platform, update, true);
+		if (getPendingCategory() != pendingBefore)
+			emit pendingUpdateChanged(getPendingCategory());
+	}
+}
+
+QString PlatformManager::getPendingCategory() const
+{
+	for (const Pipeline &pipeline : pipelines) {
+		if (pipeline.pending.active)
+			return pipeline.pending.gameName;
+	}
+	return QString();
 }
 
 void PlatformManager::fetchCurrentCategories(bool force)
 {
+	if (shuttingDown) {
+		return;
+	}
+
 	if (!force) {
-		if (categoryFetchWatcher->isRunning()) {
+		if (!pendingCategoryFetches.isEmpty()) {
 			return;
 		}
 
@@ -152,28 +359,214 @@ void PlatformManager::fetchCurrentCategories(bool force)
 
 	lastCategoryFetch = QDateTime::currentDateTime();
 
-	auto future = QtConcurrent::run([this]() {
+	// Platforms are queried concurrently and each one is reported as soon as it answers, so a
+	// slow platform does not hold back the other's dock labels.
+	int generation = ++categoryFetchGeneration;
+	pendingCategoryFetches.clear();
+
+	for (auto it = pipelines.cbegin(); it != pipelines.cend(); ++it) {
+		IPlatformService *service = it.value().service;
+		if (service && service->hasCapability(IPlatformService::ReadChannelState) && service->isAuthenticated())
+			watchChannelState(it.key(), service->getChannelState(), generation);
+	}
+
+	if (!pendingCategoryFetches.isEmpty()) {
+		categoryFetchDeadline->start(CATEGORY_FETCH_DEADLINE_MS);
+	}
+}
+
+void PlatformManager::watchChannelState(const QString &platform, const QFuture<ChannelState> &future, int generation)
+{
+	pendingCategoryFetches.insert(platform);
+
+	auto *watcher = new QFutureWatcher<ChannelState>(this);
+	connect(watcher, &QFutureWatcher<ChannelState>::finished, this, [this, watcher, platform, generation]() {
+		watcher->deleteLater();
+		if (generation != categoryFetchGeneration || !pendingCategoryFetches.remove(platform)) {
+			return;
+		}
+		if (pendingCategoryFetches.isEmpty()) {
+			categoryFetchDeadline->stop();
+		}
+
+		ChannelState state = watcher->result();
+		recordObservedState(platform, state);
 		QHash<QString, QString> results;
+		results[platform] = state.category + "|||" + state.title;
+		emit categoriesFetched(results);
+	});
+	watcher->setFuture(future);
+}
 
-		if (shuttingDown) {
-			return results;
+IPlatformService *PlatformManager::serviceFor(const QString &platform) const
+{
+	auto it = pipelines.constFind(platform);
+	return it != pipelines.cend() ? it.value().service.data() : nullptr;
+}
+
+bool PlatformManager::stateMatches(const ChannelState &state, const QString &category, const QString &title)
+{
+	// An empty title leaves the channel's title as it is.
+	return state.valid && CategoryCache::normalize(state.category) == CategoryCache::normalize(category) &&
+	       (title.isEmpty() || state.title == title);
+}
+
+bool PlatformManager::isObserved(const QString &platform, const QString &category, const QString &title) const
+{
+	auto it = observedStates.constFind(platform);
+	if (it == observedStates.cend())
+		return false;
+	if (QDateTime::currentSecsSinceEpoch() - it.value().observedAt > OBSERVED_STATE_TTL_SECONDS)
+		return false;
+	return stateMatches(it.value().state, category, title);
+}
+
+void PlatformManager::recordObservedState(const QString &platform, const ChannelState &state)
+{
+	if (!state.valid)
+		return;
+	observedStates.insert(platform, {state, QDateTime::currentSecsSinceEpoch()});
+}
+
+void PlatformManager::onServiceUpdateFinished(const QString &platform, bool success, const QString &gameName,
+					      const QString &message)
+{
+	if (shuttingDown)
+		return;
+
+	Pipeline &pipeline = pipelines[platform];
+	pipeline.inFlight = false;
+	if (pipeline.updateStartedUs >= 0) {
+		QByteArray detail = (platform + ": " + gameName + (success ? " (ok)" : " (failed)")).toUtf8();
+		Tracer::get().record("PlatformManager/categoryUpdate", "platform", pipeline.updateStartedUs,
+				     Tracer::nowUs() - pipeline.updateStartedUs, detail.constData());
+		pipeline.updateStartedUs = -1;
+	}
+	if (success) {
+		pipeline.consecutiveFailures = 0;
+		pipeline.lastError.clear();
+	} else {
+		pipeline.consecutiveFailures++;
+		pipeline.lastError = message;
+	}
+	// Deferred so this result is fully recorded before a queued update is checked against it.
+	QTimer::singleShot(0, this, [this, platform]() { runPending(platform); });
+
+	if (!success) {
+		// Show what the channel really has instead of the category that was asked for.
+		observedStates.remove(platform);
+		confirmedRequests.remove(platform);
+		reconcile(platform, false);
+		if (updateIntents.pending(platform, nullptr) && !reconcileTimer->isActive()) {
+			blog(LOG_INFO,
+			     "[GameDetector/PlatformManager] %s update to '%s' failed (%d in a row); it will be retried.",
+			     platform.toStdString().c_str(), gameName.toStdString().c_str(), pipeline.consecutiveFailures);
+			reconcileTimer->start();
 		}
+		return;
+	}
+
+	setLastSetCategory(gameName);
+	confirmedRequests.insert(platform, {gameName, pipeline.inFlightUpdate.title, true});
+	if (message == "Command sent") {
+		// The bot's reply cannot be matched to the command, so posting it counts as applying it
+		// and the command is not replayed.
+		updateIntents.resolve(platform, gameName);
+		observedStates.remove(platform);
+		QTimer::singleShot(CHAT_COMMAND_SETTLE_MS, this, [this, platform]() { reconcile(platform, false); });
+		return;
+	}
+
+	UpdateIntentQueue::Intent intent;
+	ChannelState state = observedStates.value(platform).state;
+	state.category = gameName;
+	if (updateIntents.pending(platform, &intent) && !intent.title.isEmpty())
+		state.title = intent.title;
+	state.valid = true;
+	recordObservedState(platform, state);
+	updateIntents.resolve(platform, gameName);
+
+	QHash<QString, QString> results;
+	results[platform] = state.category + "|||" + state.title;
+	emit categoriesFetched(results);
+}
+
+void PlatformManager::reconcilePendingUpdates()
+{
+	QStringList platforms = updateIntents.platforms();
+	if (platforms.isEmpty()) {
+		reconcileTimer->stop();
+		return;
+	}
+	for (const QString &platform : platforms)
+		reconcile(platform);
+}
+
+void PlatformManager::reconcile(const QString &platform, bool replay)
+{
+	if (shuttingDown || reconcilingPlatforms.contains(platform))
+		return;
+	if (replay && !updateIntents.pending(platform, nullptr))
+		return;
+
+	IPlatformService *service = serviceFor(platform);
+	if (!service || !service->hasCapability(IPlatformService::ReadChannelState) || !service->isAuthenticated())
+		return;
+
+	QFuture<ChannelState> future = service->getChannelState();
+	reconcilingPlatforms.insert(platform);
+	auto *watcher = new QFutureWatcher<ChannelState>(this);
+	connect(watcher, &QFutureWatcher<ChannelState>::finished, this, [this, watcher, platform, replay]() {
+		watcher->deleteLater();
+		reconcilingPlatforms.remove(platform);
+		if (shuttingDown)
+			return;
 
-		if (!ConfigManager::get().getTwitchUserId().isEmpty()) {
-			QString category = TwitchAuthManager::get().getChannelCategory().result();
-			QString title = TwitchAuthManager::get().getChannelTitle().result();
-			results["Twitch"] = category + "|||" + title;
+		ChannelState state = watcher->result();
+		recordObservedState(platform, state);
+		QHash<QString, QString> results;
+		results[platform] = state.category + "|||" + state.title;
+		emit categoriesFetched(results);
+
+		UpdateIntentQueue::Intent intent;
+		// Still offline, or superseded while the channel state was being read.
+		if (!state.valid || !updateIntents.pending(platform, &intent))
+			return;
+
+		if (stateMatches(state, intent.category, intent.title)) {
+			updateIntents.drop(platform);
+			setLastSetCategory(intent.category);
+			confirmedRequests.insert(platform, {intent.category, intent.title, true});
+			MetricsRegistry::get().incrementCounter(
+				"gamedetector_update_replays_total",
+				MetricsRegistry::labels({{"platform", platform}, {"result", "confirmed"}}));
+			return;
 		}
 
-		auto trovoManager = findChild<TrovoAuthManager *>();
-		if (trovoManager && trovoManager->isAuthenticated()) {
-			QString category = trovoManager->getChannelCategory().result();
-			QString title = trovoManager->getChannelTitle().result();
-			results["Trovo"] = category + "|||" + title;
+		if (!replay)
+			return;
+
+		if (updateIntents.countReplay(platform) > MAX_REPLAYS) {
+			blog(LOG_WARNING, "[GameDetector/PlatformManager] Giving up on %s update to '%s' after %d replays.",
+			     platform.toStdString().c_str(), intent.category.toStdString().c_str(), MAX_REPLAYS);
+			updateIntents.drop(platform);
+			MetricsRegistry::get().incrementCounter(
+				"gamedetector_update_replays_total",
+				MetricsRegistry::labels({{"platform", platform}, {"result", "dropped"}}));
+			return;
 		}
-		return results;
+
+		blog(LOG_INFO, "[GameDetector/PlatformManager] %s shows '%s'; replaying update to '%s'.",
+		     platform.toStdString().c_str(), state.category.toStdString().c_str(),
+		     intent.category.toStdString().c_str());
+		MetricsRegistry::get().incrementCounter(
+			"gamedetector_update_replays_total",
+			MetricsRegistry::labels({{"platform", platform}, {"result", "replayed"}}));
+		// A replay waits for an update that is already in flight, but not for the cooldown.
+		if (!pipelines[platform].inFlight)
+			dispatchUpdate(platform, {true, intent.category, intent.title, false}, false);
 	});
-	categoryFetchWatcher->setFuture(future);
+	watcher->setFuture(future);
 }
 
 void PlatformManager::onGameIdReceived() {}
@@ -182,24 +575,25 @@ void PlatformManager::onCategoryUpdateCompleted() {}
 
 void PlatformManager::onChatMessageSent() {}
 
-void PlatformManager::setCooldown()
+bool PlatformManager::isOnCooldown(const QString &platform) const
 {
-	int delaySeconds = ConfigManager::get().getActionDelay();
-	if (delaySeconds > 0) {
-		onCooldown = true;
-		cooldownTimer->start(delaySeconds * 1000);
-		emit cooldownStarted(delaySeconds);
+	if (!platform.isEmpty())
+		return pipelines.value(platform).onCooldown;
+	for (const Pipeline &pipeline : pipelines) {
+		if (pipeline.onCooldown)
+			return true;
 	}
-}
-
-bool PlatformManager::isOnCooldown() const
-{
-	return onCooldown;
+	return false;
 }
 
 int PlatformManager::getCooldownRemaining() const
 {
-	return onCooldown ? cooldownTimer->remainingTime() / 1000 : 0;
+	int remaining = 0;
+	for (const Pipeline &pipeline : pipelines) {
+		if (pipeline.onCooldown)
+			remaining = std::max(remaining, pipeline.cooldownTimer->remainingTime() / 1000);
+	}
+	return remaining;
 }
 
 void PlatformManager::setLastSetCategory(const QString &categoryName)
@@ -6,6 +6,12 @@
 #include <QFutureWatcher>
 #include <QDateTime>
 #include <QTimer>
+#include <QSet>
+#include <QHash>
+#include <QPointer>
+#include "IPlatformService.h"
+#include "CircuitBreaker.h"
+#include "UpdateIntentQueue.h"
 
 template<typename T> class QFutureWatcher;
 
@@ -19,28 +25,106 @@ public:
 		return instance;
 	}
 
-	bool sendChatMessage(const QString &message);
-	bool updateCategory(const QString &gameName, const QString &title = QString(), bool force = false);
+	// What updateCategory() did, for the platform that got furthest: Sent when any platform was
+	// called, Queued when the rest are busy, UpToDate when they already show the request and
+	// Unavailable when no selected platform can set a category.
+	enum class UpdateResult { Sent, Queued, UpToDate, Unavailable };
+
+	// An empty platform list targets every platform. Each platform runs its own pipeline, so a
+	// request is sent right away where possible and queued where that platform is busy.
+	bool sendChatMessage(const QString &message, const QStringList &platforms = QStringList());
+	// A forced update skips the comparison with what the plugin last set and is only held back
+	// where the platform was just seen showing exactly the request.
+	UpdateResult updateCategory(const QString &gameName, const QString &title = QString(), bool force = false,
+				    const QStringList &platforms = QStringList());
 	void shutdown();
-	bool isOnCooldown() const;
+	// With no platform, true while any platform is on cooldown.
+	bool isOnCooldown(const QString &platform = QString()) const;
+	// Longest remaining cooldown across platforms, in seconds.
 	int getCooldownRemaining() const;
 	void setLastSetCategory(const QString &categoryName);
 	QString getLastSetCategory() const;
+	// Category queued on any platform for the end of its cooldown, or an empty string.
+	QString getPendingCategory() const;
 	void fetchCurrentCategories(bool force = false);
+	// Adds a platform under service->platformId() and takes ownership of the service. Updates,
+	// chat messages and channel reads only reach a service that declares the matching capability.
+	bool registerService(IPlatformService *service);
+	QStringList registeredPlatforms() const;
 
 private:
 	PlatformManager();
 	~PlatformManager();
 
-	void setCooldown();
+	void watchChannelState(const QString &platform, const QFuture<ChannelState> &future, int generation);
 	QDateTime lastCategoryFetch;
-	QFutureWatcher<QHash<QString, QString>> *categoryFetchWatcher;
+	QTimer *categoryFetchDeadline;
+	QSet<QString> pendingCategoryFetches;
+	int categoryFetchGeneration = 0;
+	static constexpr int CATEGORY_FETCH_DEADLINE_MS = 10000;
 
-	QTimer *cooldownTimer;
-	bool onCooldown = false;
+	struct PendingUpdate {
+		bool active = false;
+		QString gameName;
+		QString title;
+		bool force = false;
+	};
+	// Everything that limits how fast one platform is updated. Requests made while the platform
+	// is on cooldown or has an update in flight replace each other, and the survivor runs once
+	// the platform is free again.
+	struct Pipeline {
+		QPointer<IPlatformService> service;
+		QTimer *cooldownTimer = nullptr;
+		bool onCooldown = false;
+		bool inFlight = false;
+		PendingUpdate pending;
+		// The update currently with the service, recorded as confirmed once it succeeds.
+		PendingUpdate inFlightUpdate;
+		// When inFlightUpdate was handed to the service, for its trace span. -1 when not traced.
+		int64_t updateStartedUs = -1;
+		QString pendingChatMessage;
+		int consecutiveFailures = 0;
+		QString lastError;
+	};
+	QHash<QString, Pipeline> pipelines;
+	bool isOutdated(const QString &platform, const QString &gameName, const QString &title, bool force);
+	void dispatchUpdate(const QString &platform, const PendingUpdate &update, bool recordIntent);
+	void startCooldown(const QString &platform);
+	void onCooldownExpired(const QString &platform);
+	void runPending(const QString &platform);
 
 	QString lastSetCategoryName;
 
+	// Desired state per platform lives in updateIntents, observed state in observedStates. Only
+	// platforms whose observed state differs from the request are called, and unconfirmed updates
+	// are replayed against the live channel state until the platform reports the desired category.
+	struct ObservedState {
+		ChannelState state;
+		qint64 observedAt = 0;
+	};
+	void onServiceUpdateFinished(const QString &platform, bool success, const QString &gameName,
+				     const QString &message);
+	void reconcilePendingUpdates();
+	void reconcile(const QString &platform, bool replay = true);
+	void recordObservedState(const QString &platform, const ChannelState &state);
+	bool isObserved(const QString &platform, const QString &category, const QString &title) const;
+	static bool stateMatches(const ChannelState &state, const QString &category, const QString &title);
+	IPlatformService *serviceFor(const QString &platform) const;
+	UpdateIntentQueue updateIntents;
+	QHash<QString, ObservedState> observedStates;
+	// Last request each platform accepted, as it was asked for. The platform may report the
+	// category under another name (Trovo's "Just Chatting" is "Chit Chat", a chat command only
+	// reports that it was posted), so the observed state alone cannot tell that it was applied.
+	QHash<QString, ChannelState> confirmedRequests;
+	QTimer *reconcileTimer;
+	QSet<QString> reconcilingPlatforms;
+	static constexpr int RECONCILE_INTERVAL_MS = 30000;
+	static constexpr int MAX_REPLAYS = 3;
+	// Observations older than this may no longer reflect changes made outside the plugin.
+	static constexpr qint64 OBSERVED_STATE_TTL_SECONDS = 5 * 60;
+	// A chat command is applied by a bot, so its effect is read back after this delay.
+	static constexpr int CHAT_COMMAND_SETTLE_MS = 3000;
+
 	QFutureWatcher<QString> *gameIdWatcher;
 	QFutureWatcher<bool> *chatMessageWatcher;
 	QFutureWatcher<void *> *categoryUpdateWatcher;
@@ -51,7 +135,11 @@ signals:
 	void authenticationRequired();
 	void cooldownStarted(int seconds);
 	void cooldownFinished();
+	// The category queued for the end of the cooldown changed. Empty when nothing is queued.
+	void pendingUpdateChanged(const QString &gameName);
 	void categoriesFetched(const QHash<QString, QString> &categories);
+	// A platform API stopped answering (Open), is being probed (HalfOpen) or recovered (Closed).
+	void platformHealthChanged(const QString &platform, CircuitBreaker::State state);
 
 private slots:
 	void onGameIdReceived();
@@ -12,6 +12,12 @@
 #include "GameDetectorDock.h"
 #include "PlatformManager.h"
 #include "TwitchAuthManager.h"
+#include "Tracer.h"
+#include "MetricsServer.h"
+#include "MockPlatformServer.h"
+#include "ApiEndpoints.h"
+#include "NetworkCommon.h"
+#include "NetworkEngine.h"
 
 static obs_hotkey_id g_set_game_hotkey_id;
 static obs_hotkey_id g_rescan_games_hotkey_id;
@@ -93,6 +99,22 @@ static void save_hotkeys(obs_data_t *save_data, bool saving, void *private_data)
 	obs_data_array_release(set_jc_hotkey_data);
 }
 
+// Keeps the platform API connections of every account that is logged in open, so the first
+// category change after OBS starts does not pay for DNS and the TLS handshake. Runs again on every
+// settings save, which covers network_warmup being toggled, the API base URLs changing and accounts
+// being connected or disconnected.
+static void warm_up_connections()
+{
+	std::vector<QString> urls;
+	if (ConfigManager::get().getNetworkWarmup()) {
+		if (!ConfigManager::get().getTwitchToken().isEmpty())
+			urls.push_back(ApiEndpoints::baseUrl(ApiBase::TwitchApi) + "/");
+		if (!ConfigManager::get().getTrovoToken().isEmpty())
+			urls.push_back(ApiEndpoints::baseUrl(ApiBase::TrovoApi) + "/");
+	}
+	NetworkEngine::get().setKeepAliveTargets(urls);
+}
+
 static GameDetectorDock *get_dock()
 {
 	return g_dock_widget.data();
@@ -103,7 +125,13 @@ bool obs_module_load(void)
 	blog(LOG_INFO, "[GameDetector] Plugin loaded.");
 
 	ConfigManager::get().load();
+	if (ConfigManager::get().getTraceEnabled())
+		Tracer::get().setEnabled(true);
+	// Up before the first token validation, which it answers when the API stand-in is enabled.
+	MockPlatformServer::get().applySettings();
 	TwitchAuthManager::get().loadToken();
+	warm_up_connections();
+	QObject::connect(&ConfigManager::get(), &ConfigManager::settingsSaved, [] { warm_up_connections(); });
 
 	GameDetectorDock *dockWidget = new GameDetectorDock();
 	obs_frontend_add_dock_by_id("game_detector", "Game Detector", dockWidget);
@@ -148,6 +176,8 @@ bool obs_module_load(void)
 	get_dock()->loadSettingsFromConfig();
 	blog(LOG_INFO, "[GameDetector] Config file path: %s", obs_module_config_path("config.json"));
 
+	MetricsServer::get().applySettings();
+
 	GameDetector::get().loadGamesFromConfig();
 	GameDetector::get().startScanning();
 	GameDetector::get().setupPeriodicScan();
@@ -179,8 +209,14 @@ void obs_module_unload(void)
 	obs_hotkey_unregister(g_set_just_chatting_hotkey_id);
 
 	GameDetector::get().stopScanning();
+	MetricsServer::get().stop();
+	// Cancelling the managers' requests first lets them finish as cancelled instead of being cut
+	// off while their callers still wait on them.
 	TwitchAuthManager::get().shutdown();
 	PlatformManager::get().shutdown();
+	NetworkEngine::get().shutdown();
+	MockPlatformServer::get().shutdown();
+	CurlHandlePool::get().shutdown();
 	ConfigManager::get().save(ConfigManager::get().getSettings());
 	ConfigManager::get().shutdown();
 
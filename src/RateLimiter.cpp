@@ -0,0 +1,106 @@
+#include "RateLimiter.h"
+
+#include <obs-module.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+static bool header_number(const std::map<std::string, std::string> &headers, const char *name, double *value)
+{
+	auto it = headers.find(name);
+	if (it == headers.end() || it->second.empty())
+		return false;
+
+	char *end = nullptr;
+	double parsed = std::strtod(it->second.c_str(), &end);
+	if (end == it->second.c_str())
+		return false;
+	*value = parsed;
+	return true;
+}
+
+int64_t RateLimiter::nowMs()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		       std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
+
+void RateLimiter::refill(Bucket &bucket, int64_t nowMs)
+{
+	if (nowMs > bucket.updatedMs) {
+		bucket.tokens = std::min(bucket.limit, bucket.tokens + (nowMs - bucket.updatedMs) * bucket.refillPerMs);
+		bucket.updatedMs = nowMs;
+	}
+}
+
+bool RateLimiter::acquire(const std::string &bucket, double reserve, int64_t nowMs, int64_t *waitMs)
+{
+	auto it = buckets.find(bucket);
+	if (it == buckets.end() || it->second.limit <= 0)
+		return true;
+
+	Bucket &state = it->second;
+	refill(state, nowMs);
+
+	double needed = std::max(1.0, state.limit * reserve + 1.0);
+	if (state.tokens >= needed) {
+		state.tokens -= 1.0;
+		return true;
+	}
+
+	if (waitMs) {
+		*waitMs = state.refillPerMs > 0
+				  ? static_cast<int64_t>(std::ceil((needed - state.tokens) / state.refillPerMs))
+				  : DEFAULT_BACKOFF_MS;
+	}
+	return false;
+}
+
+void RateLimiter::update(const std::string &bucket, long httpCode, const std::map<std::string, std::string> &headers,
+			 int64_t nowMs)
+{
+	double limit = 0;
+	double remaining = 0;
+	double reset = 0;
+	double retryAfter = 0;
+	bool hasLimit = header_number(headers, "ratelimit-limit", &limit) && limit > 0;
+	bool hasRemaining = header_number(headers, "ratelimit-remaining", &remaining);
+	bool hasReset = header_number(headers, "ratelimit-reset", &reset);
+	bool hasRetryAfter = header_number(headers, "retry-after", &retryAfter);
+
+	if (!hasLimit && httpCode != 429)
+		return;
+
+	Bucket &state = buckets[bucket];
+	if (hasLimit)
+		state.limit = limit;
+	else if (state.limit <= 0)
+		state.limit = 1;
+	state.tokens = httpCode == 429 ? 0 : (hasRemaining ? remaining : state.limit);
+	state.updatedMs = nowMs;
+
+	// Ratelimit-Reset is the epoch second at which the bucket is full again.
+	int64_t untilFullMs = 0;
+	if (hasReset) {
+		int64_t epochMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+					  std::chrono::system_clock::now().time_since_epoch())
+					  .count();
+		untilFullMs = static_cast<int64_t>(reset * 1000.0) - epochMs;
+	} else if (hasRetryAfter) {
+		untilFullMs = static_cast<int64_t>(retryAfter * 1000.0);
+	} else if (httpCode == 429) {
+		untilFullMs = DEFAULT_BACKOFF_MS;
+	}
+
+	state.refillPerMs = untilFullMs > 0 ? (state.limit - state.tokens) / untilFullMs : 0;
+	if (untilFullMs <= 0)
+		state.tokens = state.limit;
+
+	if (httpCode == 429) {
+		blog(LOG_WARNING, "[GameDetector/RateLimiter] Rate limit exhausted for %s; holding requests for %lld ms.",
+		     bucket.substr(0, bucket.find('#')).c_str(), static_cast<long long>(untilFullMs));
+	}
+}
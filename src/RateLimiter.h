@@ -0,0 +1,45 @@
+#ifndef RATELIMITER_H
+#define RATELIMITER_H
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Token buckets fed by the rate-limit headers a platform returns (Ratelimit-Limit,
+// Ratelimit-Remaining, Ratelimit-Reset, and Retry-After on a 429). One bucket is kept per
+// host and access token, matching how Helix accounts for requests.
+//
+// Callers ask for a token with a reserve: a request is only admitted while more than that
+// fraction of the bucket is left, so background work stops before the budget is gone and the
+// remainder stays available for what the user is waiting on. Buckets that never reported
+// headers always admit. Not thread safe; NetworkEngine only uses it from its reactor thread.
+class RateLimiter {
+public:
+	// Takes a token and returns true, or returns false and sets waitMs to the time until the
+	// bucket has refilled past the reserve.
+	bool acquire(const std::string &bucket, double reserve, int64_t nowMs, int64_t *waitMs);
+	// Resynchronises the bucket with the headers of a finished response. Header names are lowercase.
+	void update(const std::string &bucket, long httpCode, const std::map<std::string, std::string> &headers,
+		    int64_t nowMs);
+
+	static int64_t nowMs();
+
+	// Wait used when a bucket is empty and the platform gave no reset time.
+	static constexpr int64_t DEFAULT_BACKOFF_MS = 60000;
+
+private:
+	struct Bucket {
+		double limit = 0;
+		double tokens = 0;
+		double refillPerMs = 0;
+		int64_t updatedMs = 0;
+	};
+
+	static void refill(Bucket &bucket, int64_t nowMs);
+
+	std::map<std::string, Bucket> buckets;
+};
+
+#endif // RATELIMITER_H
@@ -0,0 +1,49 @@
+#include "RequestTemplate.h"
+#include "MetricsRegistry.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <cctype>
+
+HeaderSet::HeaderSet(std::vector<std::string> lines) : headerLines(std::move(lines))
+{
+	for (const std::string &line : headerLines) {
+		headerList = curl_slist_append(headerList, line.c_str());
+
+		std::string name = line.substr(0, line.find(':'));
+		std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+		if (name == "authorization")
+			authKey = std::to_string(std::hash<std::string>{}(line));
+	}
+}
+
+HeaderSet::~HeaderSet()
+{
+	curl_slist_free_all(headerList);
+}
+
+RequestTemplateCache::RequestTemplateCache(const char *platform, Builder builder)
+	: platform(platform),
+	  builder(std::move(builder))
+{
+}
+
+HeaderSetPtr RequestTemplateCache::headers(const QString &token, bool jsonBody)
+{
+	QMutexLocker locker(&mutex);
+
+	auto it = generations.find(token);
+	if (it == generations.end()) {
+		if (generations.size() >= MAX_GENERATIONS)
+			generations.clear();
+
+		Generation generation;
+		generation.plain = std::make_shared<const HeaderSet>(builder(token, false));
+		generation.json = std::make_shared<const HeaderSet>(builder(token, true));
+		it = generations.insert(token, generation);
+		MetricsRegistry::get().incrementCounter("gamedetector_http_request_templates_built_total",
+							MetricsRegistry::labels({{"platform", platform}}));
+	}
+	return jsonBody ? it.value().json : it.value().plain;
+}
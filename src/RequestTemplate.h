@@ -0,0 +1,66 @@
+#ifndef REQUESTTEMPLATE_H
+#define REQUESTTEMPLATE_H
+
+#pragma once
+
+#include <curl/curl.h>
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Immutable set of request headers. The curl_slist is built once and handed to every transfer
+// that uses the set; curl only reads it, so concurrent transfers can share it.
+class HeaderSet {
+public:
+	explicit HeaderSet(std::vector<std::string> lines);
+	~HeaderSet();
+
+	HeaderSet(const HeaderSet &) = delete;
+	HeaderSet &operator=(const HeaderSet &) = delete;
+
+	const std::vector<std::string> &lines() const { return headerLines; }
+	struct curl_slist *list() const { return headerList; }
+	// Hash of the Authorization header, or empty when there is none. Used as the rate-limit key.
+	const std::string &authorizationKey() const { return authKey; }
+
+private:
+	std::vector<std::string> headerLines;
+	struct curl_slist *headerList = nullptr;
+	std::string authKey;
+};
+
+using HeaderSetPtr = std::shared_ptr<const HeaderSet>;
+
+// Header sets of one platform, built once per access token (a token generation) instead of on
+// every request. Requests still in flight keep an older generation alive through their pointer.
+class RequestTemplateCache {
+public:
+	// Returns the header lines for a token, with Content-Type when the request carries a JSON body.
+	using Builder = std::function<std::vector<std::string>(const QString &token, bool jsonBody)>;
+
+	RequestTemplateCache(const char *platform, Builder builder);
+
+	HeaderSetPtr headers(const QString &token, bool jsonBody);
+
+	// Generations kept at once, e.g. the user token and the unauthenticated relay calls.
+	static constexpr int MAX_GENERATIONS = 4;
+
+private:
+	struct Generation {
+		HeaderSetPtr plain;
+		HeaderSetPtr json;
+	};
+
+	const char *platform;
+	Builder builder;
+	QMutex mutex;
+	QHash<QString, Generation> generations;
+};
+
+#endif // REQUESTTEMPLATE_H
@@ -0,0 +1,218 @@
+#include "Tracer.h"
+
+#include <obs-module.h>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+	const char *name = nullptr;
+	const char *category = nullptr;
+	int64_t startUs = 0;
+	int64_t durationUs = 0;
+	uint32_t threadId = 0;
+	char detail[Tracer::DETAIL_LENGTH] = {};
+};
+
+struct ThreadBuffer {
+	std::mutex mutex;
+	std::vector<TraceEvent> events = std::vector<TraceEvent>(Tracer::RING_CAPACITY);
+	size_t next = 0;
+	size_t count = 0;
+};
+
+// Buffers are handed back when their thread exits and reused by the next thread,
+// so pool threads that come and go do not grow memory without bound.
+class BufferRegistry {
+public:
+	std::shared_ptr<ThreadBuffer> acquire()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!idle.empty()) {
+			auto buffer = idle.back();
+			idle.pop_back();
+			return buffer;
+		}
+		auto buffer = std::make_shared<ThreadBuffer>();
+		all.push_back(buffer);
+		return buffer;
+	}
+
+	void release(const std::shared_ptr<ThreadBuffer> &buffer)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		idle.push_back(buffer);
+	}
+
+	std::vector<std::shared_ptr<ThreadBuffer>> snapshot()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return all;
+	}
+
+private:
+	std::mutex mutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> all;
+	std::vector<std::shared_ptr<ThreadBuffer>> idle;
+};
+
+BufferRegistry &registry()
+{
+	static BufferRegistry instance;
+	return instance;
+}
+
+std::atomic<uint32_t> nextThreadId{1};
+
+struct ThreadSlot {
+	std::shared_ptr<ThreadBuffer> buffer;
+	uint32_t threadId;
+
+	ThreadSlot() : buffer(registry().acquire()), threadId(nextThreadId++) {}
+	~ThreadSlot() { registry().release(buffer); }
+};
+
+ThreadSlot &localSlot()
+{
+	static thread_local ThreadSlot slot;
+	return slot;
+}
+
+} // namespace
+
+Tracer &Tracer::get()
+{
+	static Tracer instance;
+	return instance;
+}
+
+void Tracer::setEnabled(bool value)
+{
+	enabled.store(value, std::memory_order_relaxed);
+	blog(LOG_INFO, "[GameDetector/Tracer] Tracing %s.", value ? "enabled" : "disabled");
+}
+
+int64_t Tracer::nowUs()
+{
+	static const auto epoch = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch)
+		.count();
+}
+
+void Tracer::record(const char *name, const char *category, int64_t startUs, int64_t durationUs,
+		    const char *detail)
+{
+	ThreadSlot &slot = localSlot();
+	ThreadBuffer &buffer = *slot.buffer;
+
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	TraceEvent &event = buffer.events[buffer.next];
+	event.name = name;
+	event.category = category;
+	event.startUs = startUs;
+	event.durationUs = durationUs;
+	event.threadId = slot.threadId;
+	if (detail) {
+		strncpy(event.detail, detail, DETAIL_LENGTH - 1);
+		event.detail[DETAIL_LENGTH - 1] = '\0';
+	} else {
+		event.detail[0] = '\0';
+	}
+
+	buffer.next = (buffer.next + 1) % RING_CAPACITY;
+	if (buffer.count < RING_CAPACITY)
+		buffer.count++;
+}
+
+void Tracer::clear()
+{
+	for (const auto &buffer : registry().snapshot()) {
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		buffer->next = 0;
+		buffer->count = 0;
+	}
+}
+
+bool Tracer::exportChromeTrace(const QString &filePath)
+{
+	std::vector<TraceEvent> events;
+	for (const auto &buffer : registry().snapshot()) {
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		size_t first = (buffer->next + RING_CAPACITY - buffer->count) % RING_CAPACITY;
+		for (size_t i = 0; i < buffer->count; ++i)
+			events.push_back(buffer->events[(first + i) % RING_CAPACITY]);
+	}
+
+	std::sort(events.begin(), events.end(),
+		  [](const TraceEvent &a, const TraceEvent &b) { return a.startUs < b.startUs; });
+
+	QJsonArray traceEvents;
+	for (const TraceEvent &event : events) {
+		QJsonObject entry;
+		entry["name"] = QString::fromUtf8(event.name);
+		entry["cat"] = QString::fromUtf8(event.category);
+		entry["ph"] = "X";
+		entry["ts"] = static_cast<double>(event.startUs);
+		entry["dur"] = static_cast<double>(event.durationUs);
+		entry["pid"] = 1;
+		entry["tid"] = static_cast<int>(event.threadId);
+		if (event.detail[0] != '\0') {
+			QJsonObject args;
+			args["detail"] = QString::fromUtf8(event.detail);
+			entry["args"] = args;
+		}
+		traceEvents.append(entry);
+	}
+
+	QJsonObject root;
+	root["traceEvents"] = traceEvents;
+	root["displayTimeUnit"] = "ms";
+
+	QFile file(filePath);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		blog(LOG_WARNING, "[GameDetector/Tracer] Could not open %s for writing.", filePath.toStdString().c_str());
+		return false;
+	}
+	file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+	file.close();
+
+	blog(LOG_INFO, "[GameDetector/Tracer] Exported %d trace events to %s", static_cast<int>(events.size()),
+	     filePath.toStdString().c_str());
+	return true;
+}
+
+TraceSpan::TraceSpan(const char *name, const char *category) : name(name), category(category)
+{
+	if (Tracer::get().isEnabled()) {
+		detail[0] = '\0';
+		startUs = Tracer::nowUs();
+	}
+}
+
+TraceSpan::~TraceSpan()
+{
+	if (startUs < 0)
+		return;
+	Tracer::get().record(name, category, startUs, Tracer::nowUs() - startUs, detail);
+}
+
+void TraceSpan::setDetail(const QString &value)
+{
+	if (startUs < 0)
+		return;
+	QByteArray utf8 = value.toUtf8();
+	size_t length = std::min(static_cast<size_t>(utf8.size()), sizeof(detail) - 1);
+	memcpy(detail, utf8.constData(), length);
+	detail[length] = '\0';
+}
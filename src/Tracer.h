@@ -0,0 +1,77 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#pragma once
+
+#include <QString>
+#include <atomic>
+#include <cstdint>
+
+// Lightweight span recorder. Each thread writes into its own fixed-size ring buffer, so
+// recording never allocates and only contends with an export in progress. When tracing
+// is disabled a span costs a single relaxed atomic load.
+class Tracer {
+public:
+	static Tracer &get();
+
+	void setEnabled(bool enabled);
+	bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+	void record(const char *name, const char *category, int64_t startUs, int64_t durationUs,
+		    const char *detail = nullptr);
+	bool exportChromeTrace(const QString &filePath);
+	void clear();
+
+	static int64_t nowUs();
+
+	static constexpr size_t RING_CAPACITY = 4096;
+	static constexpr size_t DETAIL_LENGTH = 96;
+
+private:
+	Tracer() = default;
+
+	std::atomic<bool> enabled{false};
+};
+
+class TraceSpan {
+public:
+	explicit TraceSpan(const char *name, const char *category = "GameDetector");
+	~TraceSpan();
+
+	TraceSpan(const TraceSpan &) = delete;
+	TraceSpan &operator=(const TraceSpan &) = delete;
+
+	bool isActive() const { return startUs >= 0; }
+	void setDetail(const QString &detail);
+
+private:
+	const char *name;
+	const char *category;
+	int64_t startUs = -1;
+	char detail[Tracer::DETAIL_LENGTH];
+};
+
+// Span for work that starts on one thread and completes on another. It is copyable so it can
+// travel inside a completion callback; finish() records it.
+class AsyncTraceSpan {
+public:
+	explicit AsyncTraceSpan(const char *name, const char *category = "GameDetector")
+		: name(name),
+		  category(category),
+		  startUs(Tracer::get().isEnabled() ? Tracer::nowUs() : -1)
+	{
+	}
+
+	void finish() const
+	{
+		if (startUs >= 0)
+			Tracer::get().record(name, category, startUs, Tracer::nowUs() - startUs);
+	}
+
+private:
+	const char *name;
+	const char *category;
+	int64_t startUs;
+};
+
+#endif // TRACER_H
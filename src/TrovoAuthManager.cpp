@@ -1,10 +1,9 @@
 #include "TrovoAuthManager.h"
 #include "ConfigManager.h"
-#include "NetworkCommon.h"
+#include "Tracer.h"
+#include "MetricsRegistry.h"
 #include <obs-module.h>
 #include <curl/curl.h>
-#include <QtConcurrent/QtConcurrent>
-#include <QThreadPool>
 #include <QDesktopServices>
 #include <QUrl>
 #include <QUrlQuery>
@@ -12,22 +11,48 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QTimer>
-
-TrovoAuthManager::TrovoAuthManager(QObject *parent) : IPlatformService(parent)
+#include <QFutureInterface>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+TrovoAuthManager::TrovoAuthManager(QObject *parent)
+	: IPlatformService(parent),
+	  categoryCache("trovo_category_ids.json", "trovo",
+			ApiEndpoints::spec(ApiEndpoint::TrovoSearchCategory).cacheTtlSeconds,
+			CategoryCache::DEFAULT_NEGATIVE_TTL_SECONDS),
+	  requestTemplates("trovo", [this](const QString &token, bool jsonBody) {
+		  std::vector<std::string> lines = {"Accept: application/json",
+						    "client-id: " + CLIENT_ID.toStdString()};
+		  if (jsonBody)
+			  lines.push_back("Content-Type: application/json");
+		  if (!token.isEmpty())
+			  lines.push_back("Authorization: OAuth " + token.toStdString());
+		  return lines;
+	  })
 {
 	server = new QTcpServer(this);
 	authTimeoutTimer = new QTimer(this);
 	connect(server, &QTcpServer::newConnection, this, &TrovoAuthManager::onNewConnection);
 	connect(authTimeoutTimer, &QTimer::timeout, this, &TrovoAuthManager::onAuthTimerTick);
+	refreshTimer = new QTimer(this);
+	refreshTimer->setSingleShot(true);
+	connect(refreshTimer, &QTimer::timeout, this, [this]() { refreshAccessToken(currentToken(), nullptr); });
 	loadToken();
-	threadPool.setMaxThreadCount(4);
 }
 
 TrovoAuthManager::~TrovoAuthManager()
 {
 	if (server->isListening())
 		server->close();
-	threadPool.waitForDone();
+	shutdown();
+	// Completion callbacks use this object. Cancelled requests finish without waiting for the network.
+	{
+		std::unique_lock<std::mutex> lock(pendingMutex);
+		pendingFinished.wait(lock, [this]() { return pendingRequests == 0; });
+	}
 
 	for (auto sock : clientSockets) {
 		if (sock) {
@@ -45,14 +70,56 @@ TrovoAuthManager::~TrovoAuthManager()
 void TrovoAuthManager::loadToken()
 {
 	auto settings = ConfigManager::get().getSettings();
-	accessToken = ConfigManager::get().getTrovoToken();
+	{
+		QMutexLocker locker(&tokenMutex);
+		accessToken = ConfigManager::get().getTrovoToken();
+		refreshToken = obs_data_get_string(settings, "trovo_refresh_token");
+	}
 	userId = ConfigManager::get().getTrovoUserId();
-	refreshToken = obs_data_get_string(settings, "trovo_refresh_token");
+	setTokenExpiry(obs_data_get_int(settings, "trovo_token_expires_at"));
+	scheduleTokenRefresh();
+}
+
+QString TrovoAuthManager::currentToken() const
+{
+	QMutexLocker locker(&tokenMutex);
+	return accessToken;
+}
+
+void TrovoAuthManager::setTokenExpiry(qint64 expiresAtSecs)
+{
+	QMutexLocker locker(&tokenMutex);
+	tokenExpiresAt = expiresAtSecs > 0 ? QDateTime::fromSecsSinceEpoch(expiresAtSecs) : QDateTime();
+}
+
+void TrovoAuthManager::scheduleTokenRefresh()
+{
+	QDateTime expiresAt;
+	bool canRefresh = false;
+	{
+		QMutexLocker locker(&tokenMutex);
+		expiresAt = tokenExpiresAt;
+		canRefresh = !refreshToken.isEmpty();
+	}
+
+	refreshTimer->stop();
+	if (!expiresAt.isValid() || !canRefresh)
+		return;
+
+	qint64 delayMs = QDateTime::currentDateTime().msecsTo(expiresAt) - TOKEN_REFRESH_MARGIN_SECONDS * 1000;
+	refreshTimer->start(static_cast<int>(std::clamp<qint64>(delayMs, 0, std::numeric_limits<int>::max())));
+	blog(LOG_INFO, "[GameDetector/TrovoAuth] Token refresh scheduled in %lld seconds.",
+	     static_cast<long long>(std::max<qint64>(delayMs, 0) / 1000));
+}
+
+void TrovoAuthManager::shutdown()
+{
+	NetworkEngine::get().cancel(requestLifetime);
 }
 
 bool TrovoAuthManager::isAuthenticated() const
 {
-	return !accessToken.isEmpty() && !userId.isEmpty();
+	return !currentToken().isEmpty() && !userId.isEmpty();
 }
 
 void TrovoAuthManager::startAuthentication(int mode, int unifiedAuth)
@@ -66,7 +133,7 @@ void TrovoAuthManager::startAuthentication(int mode, int unifiedAuth)
 	if (!server->listen(QHostAddress::LocalHost, 31000))
 		return;
 
-	QUrl authUrl("https://open.trovo.live/page/login.html");
+	QUrl authUrl(ApiEndpoints::url(ApiEndpoint::TrovoLogin));
 	QUrlQuery query;
 	query.addQueryItem("client_id", CLIENT_ID);
 	query.addQueryItem("response_type", "code");
@@ -82,7 +149,7 @@ void TrovoAuthManager::startAuthentication(int mode, int unifiedAuth)
 					  : "channel_details_self+channel_update_self+user_details_self";
 	}
 	query.addQueryItem("scope", scope);
-	query.addQueryItem("redirect_uri", AUTH_API_URL);
+	query.addQueryItem("redirect_uri", ApiEndpoints::baseUrl(ApiBase::TrovoRelay));
 	authUrl.setQuery(query);
 	QDesktopServices::openUrl(authUrl);
 	isAuthenticating = true;
@@ -155,8 +222,11 @@ void TrovoAuthManager::onNewConnection()
 			emit authenticationTimerTick(0);
 			server->close();
 			isAuthenticating = false;
-			this->accessToken = token;
-			this->refreshToken = refresh;
+			{
+				QMutexLocker locker(&tokenMutex);
+				this->accessToken = token;
+				this->refreshToken = refresh;
+			}
 			fetchUserInfo();
 		} else {
 			blog(LOG_WARNING, "[GameDetector/TrovoAuth] No token found in request: %s",
@@ -170,69 +240,155 @@ void TrovoAuthManager::onNewConnection()
 
 void TrovoAuthManager::fetchUserInfo()
 {
-	(void)RunTaskSafe(&threadPool, "TrovoAuth/fetchUserInfo", [this]() {
-		auto result = performGETSync("https://open-api.trovo.live/openplatform/validate", accessToken);
-
-		if (result.first == 200) {
-			blog(LOG_INFO, "[GameDetector/TrovoAuth] User info fetched successfully.");
-			QJsonDocument doc = QJsonDocument::fromJson(result.second.toUtf8());
-			this->userId = doc.object()["uid"].toString();
-			QString nickName = doc.object()["nick_name"].toString();
-
-			ConfigManager::get().setTrovoToken(accessToken);
-			ConfigManager::get().setTrovoUserId(userId);
-			ConfigManager::get().setTrovoChannelLogin(nickName);
-			obs_data_set_string(ConfigManager::get().getSettings(), "trovo_refresh_token",
-					    refreshToken.toStdString().c_str());
-			ConfigManager::get().save(ConfigManager::get().getSettings());
-			emit authenticationFinished(true, nickName);
-		} else {
-			blog(LOG_ERROR,
-			     "[GameDetector/TrovoAuth] Failed to fetch user info. HTTP Code: %ld, Response: %s",
-			     result.first, result.second.toStdString().c_str());
-			emit authenticationFinished(false, obs_module_text("Auth.Error.GetUserIdFailed"));
+	submit(ApiEndpoint::TrovoValidate, QJsonObject(), currentToken(),
+	       [this](long http_code, const QByteArray &response) {
+		       // The settings and userId belong to the main thread.
+		       QMetaObject::invokeMethod(
+			       this, [this, http_code, response]() { onUserInfoReceived(http_code, response); },
+			       Qt::QueuedConnection);
+	       });
+}
+
+void TrovoAuthManager::onUserInfoReceived(long http_code, const QByteArray &response)
+{
+	if (http_code != 200) {
+		blog(LOG_ERROR, "[GameDetector/TrovoAuth] Failed to fetch user info. HTTP Code: %ld, Response: %s",
+		     http_code, response.constData());
+		emit authenticationFinished(false, obs_module_text("Auth.Error.GetUserIdFailed"));
+		return;
+	}
+
+	blog(LOG_INFO, "[GameDetector/TrovoAuth] User info fetched successfully.");
+	QJsonDocument doc = QJsonDocument::fromJson(response);
+	userId = doc.object()["uid"].toString();
+	QString nickName = doc.object()["nick_name"].toString();
+	qint64 expiresAt = static_cast<qint64>(doc.object()["expire_ts"].toVariant().toDouble());
+	setTokenExpiry(expiresAt);
+
+	QString token, refresh;
+	{
+		QMutexLocker locker(&tokenMutex);
+		token = accessToken;
+		refresh = refreshToken;
+	}
+	ConfigManager::get().setTrovoToken(token);
+	ConfigManager::get().setTrovoUserId(userId);
+	ConfigManager::get().setTrovoChannelLogin(nickName);
+	obs_data_set_string(ConfigManager::get().getSettings(), "trovo_refresh_token", refresh.toStdString().c_str());
+	obs_data_set_int(ConfigManager::get().getSettings(), "trovo_token_expires_at", expiresAt);
+	ConfigManager::get().save(ConfigManager::get().getSettings());
+	scheduleTokenRefresh();
+	emit authenticationFinished(true, nickName);
+}
+
+void TrovoAuthManager::refreshAccessToken(const QString &staleToken, std::function<void(bool)> done)
+{
+	bool replaced = false;
+	bool start = false;
+	{
+		QMutexLocker locker(&tokenMutex);
+		// Another caller already replaced the token this request was sent with.
+		replaced = !staleToken.isEmpty() && !accessToken.isEmpty() && accessToken != staleToken;
+		if (!replaced) {
+			refreshWaiters.push_back(std::move(done));
+			start = refreshWaiters.size() == 1;
 		}
-	});
+	}
+
+	if (replaced) {
+		if (done)
+			done(true);
+		return;
+	}
+	if (!start) {
+		blog(LOG_INFO, "[GameDetector/TrovoAuth] Waiting for the token refresh already in progress.");
+		return;
+	}
+	performTokenRefresh();
 }
 
-bool TrovoAuthManager::refreshAccessToken()
+void TrovoAuthManager::finishTokenRefresh(bool refreshed)
 {
-	if (lastRefreshAttempt.isValid() && lastRefreshAttempt.secsTo(QDateTime::currentDateTime()) < 5) {
-		blog(LOG_INFO, "[GameDetector/TrovoAuth] Refresh token attempt skipped due to rate limit.");
-		return false;
+	std::vector<std::function<void(bool)>> waiters;
+	{
+		QMutexLocker locker(&tokenMutex);
+		waiters.swap(refreshWaiters);
+	}
+	for (const auto &waiter : waiters) {
+		if (waiter)
+			waiter(refreshed);
 	}
-	lastRefreshAttempt = QDateTime::currentDateTime();
+}
 
-	if (refreshToken.isEmpty())
-		return false;
+void TrovoAuthManager::performTokenRefresh()
+{
+	QString currentRefreshToken;
+	bool rateLimited = false;
+	{
+		QMutexLocker locker(&tokenMutex);
+		QDateTime now = QDateTime::currentDateTime();
+		rateLimited = lastRefreshAttempt.isValid() && lastRefreshAttempt.secsTo(now) < 5;
+		if (!rateLimited)
+			lastRefreshAttempt = now;
+		currentRefreshToken = refreshToken;
+	}
+	if (rateLimited) {
+		blog(LOG_INFO, "[GameDetector/TrovoAuth] Refresh token attempt skipped due to rate limit.");
+		finishTokenRefresh(false);
+		return;
+	}
+	if (currentRefreshToken.isEmpty()) {
+		finishTokenRefresh(false);
+		return;
+	}
 
 	blog(LOG_INFO, "[GameDetector/TrovoAuth] Refreshing access token...");
 
 	QJsonObject body;
 	body["grant_type"] = "refresh_token";
-	body["refresh_token"] = refreshToken;
-
-	auto [http_code, response] = performPOSTSync(AUTH_API_URL, body, "");
+	body["refresh_token"] = currentRefreshToken;
 
-	if (http_code == 200) {
-		QJsonDocument doc = QJsonDocument::fromJson(response.toUtf8());
-		QJsonObject json = doc.object();
-
-		this->accessToken = json["access_token"].toString();
-		this->refreshToken = json["refresh_token"].toString();
+	submit(ApiEndpoint::TrovoTokenRefresh, body, QString(), [this](long http_code, const QByteArray &response) {
+		if (http_code != 200) {
+			blog(LOG_WARNING, "[GameDetector/TrovoAuth] Failed to refresh token. HTTP: %ld Response: %s",
+			     http_code, response.constData());
+			MetricsRegistry::get().incrementCounter(
+				"gamedetector_token_refreshes_total",
+				MetricsRegistry::labels({{"platform", "trovo"}, {"result", "failure"}}));
+			finishTokenRefresh(false);
+			return;
+		}
 
-		ConfigManager::get().setTrovoToken(this->accessToken);
-		obs_data_set_string(ConfigManager::get().getSettings(), "trovo_refresh_token",
-				    this->refreshToken.toStdString().c_str());
-		ConfigManager::get().save(ConfigManager::get().getSettings());
+		QJsonObject json = QJsonDocument::fromJson(response).object();
+		QString newAccessToken = json["access_token"].toString();
+		QString newRefreshToken = json["refresh_token"].toString();
+		qint64 expiresIn = static_cast<qint64>(json["expires_in"].toVariant().toDouble());
+		qint64 expiresAt = expiresIn > 0 ? QDateTime::currentSecsSinceEpoch() + expiresIn : 0;
+		{
+			QMutexLocker locker(&tokenMutex);
+			this->accessToken = newAccessToken;
+			this->refreshToken = newRefreshToken;
+		}
+		setTokenExpiry(expiresAt);
+
+		QMetaObject::invokeMethod(
+			this,
+			[this, newAccessToken, newRefreshToken, expiresAt]() {
+				ConfigManager::get().setTrovoToken(newAccessToken);
+				obs_data_set_string(ConfigManager::get().getSettings(), "trovo_refresh_token",
+						    newRefreshToken.toStdString().c_str());
+				obs_data_set_int(ConfigManager::get().getSettings(), "trovo_token_expires_at",
+						 expiresAt);
+				ConfigManager::get().save(ConfigManager::get().getSettings());
+				scheduleTokenRefresh();
+			},
+			Qt::QueuedConnection);
 
 		blog(LOG_INFO, "[GameDetector/TrovoAuth] Token refreshed successfully.");
-		return true;
-	}
-
-	blog(LOG_WARNING, "[GameDetector/TrovoAuth] Failed to refresh token. HTTP: %ld Response: %s", http_code,
-	     response.toStdString().c_str());
-	return false;
+		MetricsRegistry::get().incrementCounter("gamedetector_token_refreshes_total",
+							MetricsRegistry::labels({{"platform", "trovo"}, {"result", "success"}}));
+		finishTokenRefresh(true);
+	});
 }
 
 void TrovoAuthManager::updateCategory(const QString &gameName, const QString &title)
@@ -267,42 +423,85 @@ void TrovoAuthManager::searchAndSetCategory(const QString &gameName, const QStri
 		searchTerm = "ChitChat";
 	}
 
-	QJsonObject body;
-	body["query"] = searchTerm;
-	body["limit"] = 1;
-
-	(void)RunTaskSafe(&threadPool, "TrovoAuth/searchAndSetCategory", [this, body, gameName, title]() {
-		auto result =
-			performPOSTSync("https://open-api.trovo.live/openplatform/searchcategory", body, accessToken);
-		QString categoryId;
-		if (result.first == 200) {
-			QJsonDocument doc = QJsonDocument::fromJson(result.second.toUtf8());
-			QJsonArray list = doc.object()["category_info"].toArray();
-			if (!list.isEmpty())
-				categoryId = list.first().toObject()["id"].toString();
-		}
-
+	AsyncTraceSpan span("TrovoAuth/searchAndSetCategory", "trovo");
+	QString channelId = userId;
+	resolveCategoryId(searchTerm, [this, gameName, title, channelId, span](const QString &categoryId) {
 		if (categoryId.isEmpty()) {
+			span.finish();
 			emit categoryUpdateFinished(false, gameName, obs_module_text("Trovo.Error.GameNotFound"));
 			return;
 		}
 
 		QJsonObject updateBody;
-		updateBody["channel_id"] = this->userId;
+		updateBody["channel_id"] = channelId;
 		updateBody["category_id"] = categoryId;
 		if (!title.isEmpty())
 			updateBody["title"] = title;
-		auto updateResult = performPOSTSync("https://open-api.trovo.live/openplatform/channels/update",
-						    updateBody, accessToken);
-
-		if (updateResult.first == 200) {
-			emit categoryUpdateFinished(true, gameName, "");
-		} else {
-			emit categoryUpdateFinished(false, gameName, obs_module_text("Trovo.Error.UpdateFailed"));
-		}
+		submit(ApiEndpoint::TrovoChannelUpdate, updateBody, currentToken(),
+		       [this, gameName, span](long http_code, const QByteArray &) {
+			       span.finish();
+			       if (http_code == 200) {
+				       emit categoryUpdateFinished(true, gameName, "");
+			       } else {
+				       emit categoryUpdateFinished(false, gameName,
+								   obs_module_text("Trovo.Error.UpdateFailed"));
+			       }
+		       });
 	});
 }
 
+void TrovoAuthManager::resolveCategoryId(const QString &searchTerm, std::function<void(const QString &)> done)
+{
+	QString categoryId;
+	if (categoryCache.lookup(searchTerm, &categoryId)) {
+		done(categoryId);
+		return;
+	}
+
+	QString matchedName;
+	categoryId = categoryCache.findCategory(searchTerm, INDEX_MATCH_THRESHOLD, &matchedName);
+	if (!categoryId.isEmpty()) {
+		blog(LOG_INFO, "[GameDetector/TrovoAuth] Resolved '%s' to known category '%s' without searching.",
+		     searchTerm.toStdString().c_str(), matchedName.toStdString().c_str());
+		categoryCache.store(searchTerm, categoryId);
+		done(categoryId);
+		return;
+	}
+
+	QJsonObject body;
+	body["query"] = searchTerm;
+	body["limit"] = SEARCH_LIMIT;
+
+	submit(ApiEndpoint::TrovoSearchCategory, body, currentToken(),
+	       [this, searchTerm, done](long http_code, const QByteArray &response) {
+		       if (http_code != 200) {
+			       done(QString());
+			       return;
+		       }
+
+		       // Trovo orders results by its own relevance, which often puts a DLC or a sequel first.
+		       // Keep the closest name instead, and fall back to Trovo's order on ties.
+		       QString categoryId;
+		       double bestScore = -1.0;
+		       QJsonArray list = QJsonDocument::fromJson(response).object()["category_info"].toArray();
+		       for (const QJsonValue &value : list) {
+			       QJsonObject category = value.toObject();
+			       QString id = category["id"].toString();
+			       QString name = category["name"].toString();
+			       categoryCache.rememberCategory(id, name);
+
+			       double score = CategoryCache::similarity(searchTerm, name);
+			       if (score > bestScore) {
+				       bestScore = score;
+				       categoryId = id;
+			       }
+		       }
+
+		       categoryCache.store(searchTerm, categoryId);
+		       done(categoryId);
+	       });
+}
+
 void TrovoAuthManager::sendChatMessage(const QString &message)
 {
 	if (!isAuthenticated())
@@ -310,189 +509,169 @@ void TrovoAuthManager::sendChatMessage(const QString &message)
 	QJsonObject body;
 	body["content"] = message;
 	body["channel_id"] = userId;
-	(void)performPOST("https://open-api.trovo.live/openplatform/chat/send", body, accessToken);
+	submit(ApiEndpoint::TrovoChatSend, body, currentToken(), Completion());
 }
 
-QFuture<std::pair<long, QString>> TrovoAuthManager::performPOST(const QString &url, const QJsonObject &body,
-								const QString &token)
+void TrovoAuthManager::submit(ApiEndpoint endpoint, const QJsonObject &body, const QString &token, Completion done,
+			      bool retried)
 {
-	return RunTaskSafe(&threadPool, "TrovoAuth/performPOST",
-			   [this, url, body, token]() -> std::pair<long, QString> {
-				   return performPOSTSync(url, body, token);
-			   });
-}
-
-QFuture<std::pair<long, QString>> TrovoAuthManager::performGET(const QString &url, const QString &token)
-{
-	return RunTaskSafe(&threadPool, "TrovoAuth/performGET",
-			   [this, url, token]() -> std::pair<long, QString> { return performGETSync(url, token); });
-}
-
-std::pair<long, QString> TrovoAuthManager::performPOSTSync(const QString &url, const QJsonObject &body,
-							   const QString &token)
-{
-	struct curl_slist *headers = nullptr;
-	headers = curl_slist_append(headers, ("client-id: " + CLIENT_ID.toStdString()).c_str());
-	headers = curl_slist_append(headers, "Content-Type: application/json");
-	headers = curl_slist_append(headers, "Accept: application/json");
-
-	if (!token.isEmpty()) {
-		std::string auth = "Authorization: OAuth " + token.toStdString();
-		headers = curl_slist_append(headers, auth.c_str());
+	const char *method = ApiEndpoints::spec(endpoint).method;
+	bool hasBody = strcmp(method, "GET") != 0;
+	NetworkRequest request = ApiEndpoints::request(endpoint);
+	request.headerSet = requestTemplates.headers(token, hasBody);
+	request.cancellation = requestLifetime;
+	if (hasBody)
+		request.body = QJsonDocument(body).toJson(QJsonDocument::Compact);
+	else
+		request.verbose = true;
+
+	{
+		std::lock_guard<std::mutex> lock(pendingMutex);
+		pendingRequests++;
 	}
-	QJsonDocument doc(body);
-	std::string json = doc.toJson(QJsonDocument::Compact).toStdString();
-
-	auto [http_code, response] = ExecuteNetworkRequest(url, "POST", headers, json);
-	curl_slist_free_all(headers);
-
-	if (http_code < 200 || http_code >= 300) {
-		blog(LOG_WARNING, "[GameDetector/TrovoAuth] Error in POST request to Trovo API (Status: %ld): %s",
-		     http_code, response.toStdString().c_str());
-
-		if (http_code == 401 && !refreshToken.isEmpty()) {
-			QJsonDocument doc = QJsonDocument::fromJson(response.toUtf8());
-			if (doc.isObject() && doc.object().value("error").toString() == "accessTokenExpired") {
-				if (refreshAccessToken()) {
-					blog(LOG_INFO,
-					     "[GameDetector/TrovoAuth] Retrying POST request with new token...");
-					return performPOSTSync(url, body, accessToken);
-				}
+	NetworkEngine::get().submit(request, [this, endpoint, body, token, done, retried,
+					      method](const NetworkResponse &response) {
+		long http_code = 0;
+		QByteArray responseBody;
+		if (response.error == CURLE_OK && !response.cancelled) {
+			http_code = response.httpCode;
+			responseBody = response.body;
+		}
+
+		bool refreshing = false;
+		if (!response.cancelled && (http_code < 200 || http_code >= 300)) {
+			blog(LOG_WARNING, "[GameDetector/TrovoAuth] Error in %s request to Trovo API (Status: %ld): %s",
+			     method, http_code, responseBody.constData());
+
+			QJsonDocument doc = QJsonDocument::fromJson(responseBody);
+			if (http_code == 401 && !token.isEmpty() && !retried && doc.isObject() &&
+			    doc.object().value("error").toString() == "accessTokenExpired") {
+				refreshing = true;
+				refreshAccessToken(token, [this, endpoint, body, done, method, http_code,
+							   responseBody](bool refreshed) {
+					if (!refreshed) {
+						if (done)
+							done(http_code, responseBody);
+						return;
+					}
+					blog(LOG_INFO, "[GameDetector/TrovoAuth] Retrying %s request with new token...",
+					     method);
+					submit(endpoint, body, currentToken(), done, true);
+				});
 			}
 		}
-	}
+		if (!refreshing && done)
+			done(http_code, responseBody);
 
-	return {http_code, response};
+		std::lock_guard<std::mutex> lock(pendingMutex);
+		if (--pendingRequests == 0)
+			pendingFinished.notify_all();
+	});
 }
 
-std::pair<long, QString> TrovoAuthManager::performGETSync(const QString &url, const QString &token)
+ChannelState TrovoAuthManager::parseChannelState(long http_code, const QByteArray &response)
 {
-	struct curl_slist *headers = nullptr;
-
-	headers = curl_slist_append(headers, "Accept: application/json");
-	std::string clientIdHeader = "client-id: " + CLIENT_ID.toStdString();
-	headers = curl_slist_append(headers, clientIdHeader.c_str());
-
-	if (!token.isEmpty()) {
-		std::string authHeader = "Authorization: OAuth " + token.toStdString();
-		headers = curl_slist_append(headers, authHeader.c_str());
+	ChannelState state;
+	QJsonDocument doc = QJsonDocument::fromJson(response);
+
+	if (http_code != 200) {
+		QString message = doc.isObject() ? doc.object()["message"].toString() : QString();
+		state.category = message.isEmpty() ? QString("Erro: HTTP %1").arg(http_code) : "Erro: " + message;
+		blog(LOG_WARNING, "[GameDetector/TrovoAuth] Channel info HTTP %ld: %s", http_code,
+		     response.constData());
+		return state;
 	}
 
-	auto [http_code, response] = ExecuteNetworkRequest(url, "GET", headers, "", true);
-	curl_slist_free_all(headers);
-
-	if (http_code < 200 || http_code >= 300) {
-		blog(LOG_WARNING, "[GameDetector/TrovoAuth] Error in GET request to Trovo API (Status: %ld): %s",
-		     http_code, response.toStdString().c_str());
-
-		if (http_code == 401 && !refreshToken.isEmpty()) {
-			QJsonDocument doc = QJsonDocument::fromJson(response.toUtf8());
-			if (doc.isObject() && doc.object().value("error").toString() == "accessTokenExpired") {
-				if (refreshAccessToken()) {
-					blog(LOG_INFO,
-					     "[GameDetector/TrovoAuth] Retrying GET request with new token...");
-					return performGETSync(url, accessToken);
-				}
-			}
-		}
+	if (!doc.isObject()) {
+		state.category = "Erro: Resposta da API inválida";
+		return state;
 	}
 
-	return {http_code, response};
+	state.category = doc.object()["category_name"].toString();
+	state.title = parseChannelTitle(doc.object());
+	state.valid = true;
+	if (state.title.isEmpty()) {
+		blog(LOG_INFO, "[GameDetector/TrovoAuth] Channel info: no title found in response: %s",
+		     response.constData());
+	}
+	return state;
 }
 
-QFuture<QString> TrovoAuthManager::getChannelCategory()
+QString TrovoAuthManager::parseChannelTitle(const QJsonObject &obj)
 {
-	if (!isAuthenticated()) {
-		return QtConcurrent::run(&threadPool, []() { return QString(); });
+	// Direct common fields
+	if (obj.contains("title") && obj["title"].isString())
+		return obj["title"].toString();
+	if (obj.contains("stream_title") && obj["stream_title"].isString())
+		return obj["stream_title"].toString();
+	if (obj.contains("live_title") && obj["live_title"].isString())
+		return obj["live_title"].toString();
+	if (obj.contains("channel_name") && obj["channel_name"].isString())
+		return obj["channel_name"].toString();
+	if (obj.contains("channel_title") && obj["channel_title"].isString())
+		return obj["channel_title"].toString();
+
+	// Nested objects (common Trovo structures)
+	if (obj.contains("stream_info") && obj["stream_info"].isObject()) {
+		QJsonObject s = obj["stream_info"].toObject();
+		if (s.contains("title") && s["title"].isString())
+			return s["title"].toString();
+		if (s.contains("stream_title") && s["stream_title"].isString())
+			return s["stream_title"].toString();
+		if (s.contains("live_title") && s["live_title"].isString())
+			return s["live_title"].toString();
 	}
 
-	return RunTaskSafe(&threadPool, "TrovoAuth/getChannelCategory", [this]() -> QString {
-		auto [http_code, response] =
-			performGETSync("https://open-api.trovo.live/openplatform/channel", accessToken);
+	if (obj.contains("channel_info") && obj["channel_info"].isObject()) {
+		QJsonObject c = obj["channel_info"].toObject();
+		if (c.contains("title") && c["title"].isString())
+			return c["title"].toString();
+	}
 
-		QJsonDocument doc = QJsonDocument::fromJson(response.toUtf8());
-		if (http_code == 200) {
-			if (doc.isObject()) {
-				return doc.object()["category_name"].toString();
-			}
-			return "Erro: Resposta da API inválida";
+	// Sometimes API returns data array
+	if (obj.contains("data") && obj["data"].isArray()) {
+		QJsonArray arr = obj["data"].toArray();
+		if (!arr.isEmpty() && arr.first().isObject()) {
+			QJsonObject first = arr.first().toObject();
+			if (first.contains("title") && first["title"].isString())
+				return first["title"].toString();
+			if (first.contains("stream_title") && first["stream_title"].isString())
+				return first["stream_title"].toString();
+			if (first.contains("live_title") && first["live_title"].isString())
+				return first["live_title"].toString();
 		}
+	}
 
-		if (doc.isObject()) {
-			QString message = doc.object()["message"].toString();
-			if (!message.isEmpty()) {
-				return "Erro: " + message;
-			}
-		}
-		return QString("Erro: HTTP %1").arg(http_code);
-	});
+	return QString();
 }
 
-QFuture<QString> TrovoAuthManager::getChannelTitle()
+template<typename T, typename Map> QFuture<T> TrovoAuthManager::readChannel(Map map)
 {
-	if (!isAuthenticated()) {
-		return QtConcurrent::run(&threadPool, []() { return QString(); });
-	}
-
-	return RunTaskSafe(&threadPool, "TrovoAuth/getChannelTitle", [this]() -> QString {
-		auto [http_code, response] =
-			performGETSync("https://open-api.trovo.live/openplatform/channel", accessToken);
-		QJsonDocument doc = QJsonDocument::fromJson(response.toUtf8());
-		if (http_code == 200 && doc.isObject()) {
-			QJsonObject obj = doc.object();
-
-			// Direct common fields
-			if (obj.contains("title") && obj["title"].isString())
-				return obj["title"].toString();
-			if (obj.contains("stream_title") && obj["stream_title"].isString())
-				return obj["stream_title"].toString();
-			if (obj.contains("live_title") && obj["live_title"].isString())
-				return obj["live_title"].toString();
-			if (obj.contains("channel_name") && obj["channel_name"].isString())
-				return obj["channel_name"].toString();
-			if (obj.contains("channel_title") && obj["channel_title"].isString())
-				return obj["channel_title"].toString();
-
-			// Nested objects (common Trovo structures)
-			if (obj.contains("stream_info") && obj["stream_info"].isObject()) {
-				QJsonObject s = obj["stream_info"].toObject();
-				if (s.contains("title") && s["title"].isString())
-					return s["title"].toString();
-				if (s.contains("stream_title") && s["stream_title"].isString())
-					return s["stream_title"].toString();
-				if (s.contains("live_title") && s["live_title"].isString())
-					return s["live_title"].toString();
-			}
+	if (!isAuthenticated())
+		return MakeReadyFuture(T());
+
+	auto promise = std::make_shared<QFutureInterface<T>>();
+	promise->reportStarted();
+	QFuture<T> future = promise->future();
+	submit(ApiEndpoint::TrovoChannel, QJsonObject(), currentToken(),
+	       [this, promise, map](long http_code, const QByteArray &response) {
+		       promise->reportResult(map(parseChannelState(http_code, response)));
+		       promise->reportFinished();
+	       });
+	return future;
+}
 
-			if (obj.contains("channel_info") && obj["channel_info"].isObject()) {
-				QJsonObject c = obj["channel_info"].toObject();
-				if (c.contains("title") && c["title"].isString())
-					return c["title"].toString();
-			}
+QFuture<ChannelState> TrovoAuthManager::getChannelState()
+{
+	return readChannel<ChannelState>([](const ChannelState &state) { return state; });
+}
 
-			// Sometimes API returns data array
-			if (doc.isObject() && obj.contains("data") && obj["data"].isArray()) {
-				QJsonArray arr = obj["data"].toArray();
-				if (!arr.isEmpty() && arr.first().isObject()) {
-					QJsonObject first = arr.first().toObject();
-					if (first.contains("title") && first["title"].isString())
-						return first["title"].toString();
-					if (first.contains("stream_title") && first["stream_title"].isString())
-						return first["stream_title"].toString();
-					if (first.contains("live_title") && first["live_title"].isString())
-						return first["live_title"].toString();
-				}
-			}
-		}
-		// If we reached here without returning a title, log response for debugging
-		if (http_code != 200) {
-			blog(LOG_WARNING, "[GameDetector/TrovoAuth] getChannelTitle HTTP %ld: %s", http_code,
-			     response.toStdString().c_str());
-		} else {
-			blog(LOG_INFO, "[GameDetector/TrovoAuth] getChannelTitle: no title found in response: %s",
-			     response.toStdString().c_str());
-		}
+QFuture<QString> TrovoAuthManager::getChannelCategory()
+{
+	return readChannel<QString>([](const ChannelState &state) { return state.category; });
+}
 
-		return QString();
-	});
+QFuture<QString> TrovoAuthManager::getChannelTitle()
+{
+	return readChannel<QString>([](const ChannelState &state) { return state.title; });
 }
@@ -1,14 +1,22 @@
 #pragma once
 
 #include "IPlatformService.h"
+#include "CategoryCache.h"
+#include "NetworkEngine.h"
+#include "ApiEndpoints.h"
 #include <QTcpServer>
 #include <QFuture>
 #include <QJsonObject>
-#include <QThreadPool>
 #include <QTimer>
 #include <QDateTime>
 #include <QPointer>
 #include <QList>
+#include <QMutex>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
 
 class TrovoAuthManager : public IPlatformService {
 	Q_OBJECT
@@ -17,6 +25,10 @@ public:
 	explicit TrovoAuthManager(QObject *parent = nullptr);
 	~TrovoAuthManager();
 
+	QString platformId() const override { return "Trovo"; }
+	int capabilities() const override { return UpdateCategory | UpdateTitle | SendChat | ReadChannelState; }
+	void shutdown() override;
+
 	void startAuthentication(int mode = -1, int unifiedAuth = -1);
 	bool isAuthenticated() const override;
 	void updateCategory(const QString &gameName, const QString &title = QString()) override;
@@ -26,6 +38,7 @@ public:
 
 	QFuture<QString> getChannelCategory();
 	QFuture<QString> getChannelTitle();
+	QFuture<ChannelState> getChannelState() override;
 
 signals:
 	void authenticationFinished(bool success, QString message);
@@ -39,24 +52,54 @@ private:
 	bool isAuthenticating = false;
 
 	QTimer *authTimeoutTimer = nullptr;
+	QTimer *refreshTimer = nullptr;
 	QDateTime lastRefreshAttempt;
+	QDateTime tokenExpiresAt;
+
+	// Guards accessToken, refreshToken, tokenExpiresAt and lastRefreshAttempt, which completion
+	// callbacks read on the reactor thread while a refresh replaces them, and the callers waiting
+	// for the single in-flight refresh.
+	mutable QMutex tokenMutex;
+	std::vector<std::function<void(bool)>> refreshWaiters;
 	int authRemainingSeconds = 0;
-	QThreadPool threadPool;
+	// Requests whose completion callback has not run yet. The destructor waits for them.
+	std::mutex pendingMutex;
+	std::condition_variable pendingFinished;
+	int pendingRequests = 0;
 	QList<QPointer<QTcpSocket>> clientSockets;
+	CategoryCache categoryCache;
+	RequestTemplateCache requestTemplates;
+	// Attached to every request so destruction does not wait for network I/O.
+	CancellationToken requestLifetime = CancellationToken::create();
 
-	const QString AUTH_API_URL = "https://trovo-obs.areaz12server.net.br";
 	const QString CLIENT_ID = "b07641be5083b975423de98ee83e8e0a";
+	static constexpr int SEARCH_LIMIT = 10;
+	static constexpr double INDEX_MATCH_THRESHOLD = 0.9;
+	static constexpr qint64 TOKEN_REFRESH_MARGIN_SECONDS = 5 * 60;
 
 	void onNewConnection();
 	void onAuthTimerTick();
 	void fetchUserInfo();
 	void searchAndSetCategory(const QString &gameName, const QString &title = QString());
-	bool refreshAccessToken();
-
-	QFuture<std::pair<long, QString>> performPOST(const QString &url, const QJsonObject &body,
-						      const QString &token);
-	QFuture<std::pair<long, QString>> performGET(const QString &url, const QString &token);
+	void onUserInfoReceived(long http_code, const QByteArray &response);
+	// Calls done with an empty id when the category is not found.
+	void resolveCategoryId(const QString &searchTerm, std::function<void(const QString &)> done);
+	ChannelState parseChannelState(long http_code, const QByteArray &response);
+	static QString parseChannelTitle(const QJsonObject &obj);
+	QString currentToken() const;
+	// Calls done once the token that got a 401 has been replaced, or failed to be.
+	void refreshAccessToken(const QString &staleToken, std::function<void(bool)> done);
+	void performTokenRefresh();
+	void finishTokenRefresh(bool refreshed);
+	void setTokenExpiry(qint64 expiresAtSecs);
+	void scheduleTokenRefresh();
 
-	std::pair<long, QString> performPOSTSync(const QString &url, const QJsonObject &body, const QString &token);
-	std::pair<long, QString> performGETSync(const QString &url, const QString &token);
+	// Completion callbacks run on the reactor thread. httpCode is 0 when the request failed or was
+	// cancelled.
+	using Completion = std::function<void(long httpCode, const QByteArray &body)>;
+	// Timeout, priority and retry policy come from the endpoint's entry in ApiEndpoints. The body is
+	// only sent for methods other than GET. A 401 for an expired token refreshes it and retries once.
+	void submit(ApiEndpoint endpoint, const QJsonObject &body, const QString &token, Completion done,
+		    bool retried = false);
+	template<typename T, typename Map> QFuture<T> readChannel(Map map);
 };
@@ -1,11 +1,11 @@
 #include "TwitchAuthManager.h"
 #include "ConfigManager.h"
-#include "NetworkCommon.h"
+#include "NetworkEngine.h"
+#include "Tracer.h"
 
 #include <obs-module.h>
 #include <curl/curl.h>
 
-#include <QtConcurrent/QtConcurrent>
 #include <QDesktopServices>
 #include <QUrl>
 #include <QTcpServer>
@@ -15,6 +15,7 @@
 #include <QJsonArray>
 #include <QTimer>
 #include <QCoreApplication>
+#include <QSet>
 
 static const QString SVG_SUCCESS =
 	"<svg xmlns='http://www.w3.org/2000/svg' width='64' height='64' viewBox='0 0 24 24' fill='none' stroke='#4caf50' stroke-width='2' stroke-linecap='round' stroke-linejoin='round'><path d='M22 11.08V12a10 10 0 1 1-5.93-9.14'></path><polyline points='22 4 12 14.01 9 11.01'></polyline></svg>";
@@ -56,16 +57,28 @@ static QString GetAuthPageTemplate(const QString &title, const QString &bodyCont
 		.arg(title, css, bodyContent, footerText, script);
 }
 
-TwitchAuthManager::TwitchAuthManager(QObject *parent) : QObject(parent)
+TwitchAuthManager::TwitchAuthManager(QObject *parent)
+	: QObject(parent),
+	  gameIdCache("twitch_game_ids.json", "twitch", ApiEndpoints::spec(ApiEndpoint::TwitchGames).cacheTtlSeconds,
+		      CategoryCache::DEFAULT_NEGATIVE_TTL_SECONDS),
+	  requestTemplates("twitch", [](const QString &token, bool jsonBody) {
+		  std::vector<std::string> lines = {"Authorization: Bearer " + token.toStdString(),
+						    std::string("Client-ID: ") + CLIENT_ID};
+		  if (jsonBody)
+			  lines.push_back("Content-Type: application/json");
+		  return lines;
+	  })
 {
 	server = new QTcpServer(this);
 	authTimeoutTimer = new QTimer(this);
+	tokenValidationTimer = new QTimer(this);
+	tokenValidationTimer->setInterval(TOKEN_VALIDATION_INTERVAL_MS);
 
 	connect(server, &QTcpServer::newConnection, this, &TwitchAuthManager::onNewConnection);
 	connect(this, &TwitchAuthManager::authenticationDataNeedsClearing, this,
 		&TwitchAuthManager::clearAuthentication, Qt::QueuedConnection);
 	connect(authTimeoutTimer, &QTimer::timeout, this, &TwitchAuthManager::onAuthTimerTick);
-	threadPool.setMaxThreadCount(4);
+	connect(tokenValidationTimer, &QTimer::timeout, this, &TwitchAuthManager::validateToken);
 }
 
 TwitchAuthManager::~TwitchAuthManager()
@@ -76,6 +89,10 @@ TwitchAuthManager::~TwitchAuthManager()
 
 void TwitchAuthManager::shutdown()
 {
+	prewarmGeneration++;
+	NetworkEngine::get().cancel(requestLifetime);
+	gameIdCache.flush();
+
 	QObject::disconnect(this, &TwitchAuthManager::authenticationDataNeedsClearing, this,
 			    &TwitchAuthManager::clearAuthentication);
 	QCoreApplication::removePostedEvents(this);
@@ -83,10 +100,12 @@ void TwitchAuthManager::shutdown()
 	if (authTimeoutTimer && authTimeoutTimer->isActive()) {
 		authTimeoutTimer->stop();
 	}
+	if (tokenValidationTimer) {
+		tokenValidationTimer->stop();
+	}
 	if (server && server->isListening()) {
 		server->close();
 	}
-	threadPool.waitForDone();
 
 	for (auto sock : clientSockets) {
 		if (sock) {
@@ -106,6 +125,7 @@ void TwitchAuthManager::loadToken()
 	auto settings = ConfigManager::get().getSettings();
 	accessToken = obs_data_get_string(settings, "twitch_access_token");
 	userId = obs_data_get_string(settings, "twitch_user_id");
+	validateToken();
 }
 
 void TwitchAuthManager::startAuthentication(int mode, int unifiedAuth)
@@ -126,7 +146,7 @@ void TwitchAuthManager::startAuthentication(int mode, int unifiedAuth)
 
 	blog(LOG_INFO, "[GameDetector/TwitchAuth] Local server started at http://localhost:30000/");
 
-	QUrl authUrl("https://id.twitch.tv/oauth2/authorize");
+	QUrl authUrl(ApiEndpoints::url(ApiEndpoint::TwitchAuthorize));
 	QUrlQuery query;
 
 	query.addQueryItem("client_id", CLIENT_ID);
@@ -161,6 +181,10 @@ void TwitchAuthManager::clearAuthentication()
 {
 	accessToken.clear();
 	userId.clear();
+	tokenState = TokenState::Unknown;
+	tokenExpiresAt = QDateTime();
+	renewalRequested = false;
+	tokenValidationTimer->stop();
 	if (!ConfigManager::get().getSettings()) {
 		return;
 	}
@@ -244,6 +268,7 @@ void TwitchAuthManager::onNewConnection()
 				obs_data_set_string(settings, "twitch_channel_login", loginName.toStdString().c_str());
 				obs_data_set_string(settings, "twitch_refresh_token", "");
 				ConfigManager::get().save(settings);
+				validateToken();
 				emit authenticationFinished(true, loginName);
 			} else {
 				obs_data_set_string(settings, "twitch_access_token", "");
@@ -302,28 +327,143 @@ QString TwitchAuthManager::getUserId()
 	return userId;
 }
 
-QFuture<std::pair<long, QString>> TwitchAuthManager::performGET(const QString &url, const QString &token)
+bool TwitchAuthManager::hasUsableToken() const
+{
+	if (accessToken.isEmpty() || tokenState == TokenState::Invalid)
+		return false;
+	return !tokenExpiresAt.isValid() || tokenExpiresAt > QDateTime::currentDateTimeUtc();
+}
+
+void TwitchAuthManager::validateToken()
 {
-	return RunTaskSafe(&threadPool, "TwitchAuth/performGET",
-			   [this, url, token]() -> std::pair<long, QString> { return performGETSync(url, token); });
+	if (accessToken.isEmpty()) {
+		tokenValidationTimer->stop();
+		return;
+	}
+	if (!tokenValidationTimer->isActive())
+		tokenValidationTimer->start();
+
+	NetworkRequest request = ApiEndpoints::request(ApiEndpoint::TwitchValidate);
+	request.headers.push_back("Authorization: OAuth " + accessToken.toStdString());
+	request.cancellation = requestLifetime;
+
+	QString token = accessToken;
+	NetworkEngine::get().submit(request, [this, token](const NetworkResponse &response) {
+		if (response.error != CURLE_OK || response.cancelled || response.throttled || response.circuitOpen)
+			return;
+		long httpCode = response.httpCode;
+		QByteArray body = response.body;
+		QMetaObject::invokeMethod(
+			this, [this, token, httpCode, body]() { onTokenValidated(token, httpCode, body); },
+			Qt::QueuedConnection);
+	});
+}
+
+void TwitchAuthManager::onTokenValidated(const QString &token, long httpCode, const QByteArray &body)
+{
+	// The token may have been replaced or cleared while the request was in flight.
+	if (token != accessToken)
+		return;
+
+	if (httpCode == 401) {
+		invalidateToken("rejected by Twitch");
+		return;
+	}
+	if (httpCode != 200)
+		return;
+
+	QJsonObject info = QJsonDocument::fromJson(body).object();
+	qint64 expiresIn = static_cast<qint64>(info["expires_in"].toDouble());
+	tokenState = TokenState::Valid;
+	// Twitch reports 0 for tokens that do not expire.
+	tokenExpiresAt = expiresIn > 0 ? QDateTime::currentDateTimeUtc().addSecs(expiresIn) : QDateTime();
+
+	if (expiresIn > 0 && expiresIn < TOKEN_RENEWAL_MARGIN_SECONDS && !renewalRequested) {
+		renewalRequested = true;
+		blog(LOG_WARNING,
+		     "[GameDetector/TwitchAuth] Twitch token expires in %lld minutes. Please reconnect your account.",
+		     static_cast<long long>(expiresIn / 60));
+		emit reauthenticationNeeded();
+	}
+
+	if (tokenExpiresAt.isValid()) {
+		qint64 untilExpiryMs = QDateTime::currentDateTimeUtc().msecsTo(tokenExpiresAt);
+		if (untilExpiryMs < TOKEN_VALIDATION_INTERVAL_MS)
+			QTimer::singleShot(untilExpiryMs + 1000, this, [this, token]() {
+				if (token == accessToken && !hasUsableToken())
+					invalidateToken("expired");
+			});
+	}
 }
 
-QFuture<std::pair<long, QString>> TwitchAuthManager::performPATCH(const QString &url, const QJsonObject &body,
-								  const QString &token)
+void TwitchAuthManager::invalidateToken(const char *reason)
 {
-	return RunTaskSafe(&threadPool, "TwitchAuth/performPATCH",
-			   [this, url, body, token]() -> std::pair<long, QString> {
-				   return performPATCHSync(url, body, token);
-			   });
+	if (tokenState == TokenState::Invalid)
+		return;
+
+	blog(LOG_WARNING, "[GameDetector/TwitchAuth] Twitch token %s. Initiating reauthentication process.", reason);
+	tokenState = TokenState::Invalid;
+	emit authenticationDataNeedsClearing();
+	emit reauthenticationNeeded();
 }
 
-QFuture<std::pair<long, QString>> TwitchAuthManager::performPOST(const QString &url, const QJsonObject &body,
-								 const QString &token)
+NetworkRequest TwitchAuthManager::buildRequest(ApiEndpoint endpoint, const QString &token, const QString &query,
+					       const QJsonObject &body) const
 {
-	return RunTaskSafe(&threadPool, "TwitchAuth/performPOST",
-			   [this, url, body, token]() -> std::pair<long, QString> {
-				   return performPOSTSync(url, body, token);
-			   });
+	NetworkRequest request = ApiEndpoints::request(endpoint, query);
+	bool hasBody = request.method != "GET";
+	request.headerSet = requestTemplates.headers(token, hasBody);
+	request.cancellation = requestLifetime;
+
+	if (hasBody)
+		request.body = QJsonDocument(body).toJson(QJsonDocument::Compact);
+	return request;
+}
+
+std::pair<long, QByteArray> TwitchAuthManager::handleResponse(const char *method, const QString &url,
+							   const NetworkResponse &response)
+{
+	if (response.error != CURLE_OK || response.cancelled)
+		return {0, ""};
+
+	if (response.throttled) {
+		blog(LOG_INFO,
+		     "[GameDetector/TwitchAuth] %s request to %s skipped to keep the Twitch rate limit budget for user actions.",
+		     method, url.toStdString().c_str());
+		return {response.httpCode, ""};
+	}
+
+	if (response.circuitOpen) {
+		blog(LOG_INFO, "[GameDetector/TwitchAuth] %s request to %s skipped while the Twitch API is not responding.",
+		     method, url.toStdString().c_str());
+		return {response.httpCode, ""};
+	}
+
+	long http_code = response.httpCode;
+	if (http_code < 200 || http_code >= 300) {
+		if (http_code == 401) {
+			blog(LOG_WARNING,
+			     "[GameDetector/TwitchAuth] Invalid token (401 Unauthorized) in %s request to %s. Initiating reauthentication process.",
+			     method, url.toStdString().c_str());
+			emit authenticationDataNeedsClearing();
+			emit reauthenticationNeeded();
+			return {http_code, ""};
+		} else if (http_code == 429) {
+			blog(LOG_WARNING,
+			     "[GameDetector/TwitchAuth] Twitch API rate limit exceeded (429 Too Many Requests). Please wait a moment and try again.");
+		}
+		blog(LOG_WARNING, "[GameDetector/TwitchAuth] Error in %s request to Twitch API (Status: %ld): %s", method,
+		     http_code, response.body.constData());
+	}
+
+	return {http_code, response.body};
+}
+
+std::pair<long, QByteArray> TwitchAuthManager::performGETSync(ApiEndpoint endpoint, const QString &token)
+{
+	NetworkRequest request = buildRequest(endpoint, token);
+	NetworkResponse response = NetworkEngine::get().submit(request).result();
+	return handleResponse("GET", request.url, response);
 }
 
 std::pair<QString, QString> TwitchAuthManager::getTokenUserInfo()
@@ -331,11 +471,10 @@ std::pair<QString, QString> TwitchAuthManager::getTokenUserInfo()
 	if (accessToken.isEmpty())
 		return {"", ""};
 
-	QString url = "https://api.twitch.tv/helix/users";
-	auto [http_code, json] = performGETSync(url, accessToken);
+	auto [http_code, json] = performGETSync(ApiEndpoint::TwitchUsers, accessToken);
 
 	if (http_code == 200) {
-		QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
+		QJsonDocument doc = QJsonDocument::fromJson(json);
 		if (doc.isObject()) {
 			QJsonArray arr = doc["data"].toArray();
 			if (!arr.isEmpty()) {
@@ -347,69 +486,159 @@ std::pair<QString, QString> TwitchAuthManager::getTokenUserInfo()
 	return {"", ""};
 }
 
+bool TwitchAuthManager::getCachedGameId(const QString &gameName, QString *gameId)
+{
+	return gameIdCache.lookup(gameName, gameId);
+}
+
 QFuture<QString> TwitchAuthManager::getGameId(const QString &gameName)
 {
-	QString url = "https://api.twitch.tv/helix/games?name=" + QUrl::toPercentEncoding(gameName);
+	QString cachedId;
+	if (gameIdCache.lookup(gameName, &cachedId))
+		return MakeReadyFuture(cachedId);
+	if (!hasUsableToken())
+		return MakeReadyFuture(QString());
+
+	QString query = "name=" + QString::fromUtf8(QUrl::toPercentEncoding(gameName));
+	NetworkRequest request = buildRequest(ApiEndpoint::TwitchGames, accessToken, query);
+	QString url = request.url;
+	AsyncTraceSpan span("TwitchAuth/getGameId", "twitch");
+
+	return NetworkEngine::get().submitMapped<QString>(
+		request, "TwitchAuth/getGameId",
+		[this, url, gameName, span](const NetworkResponse &response) -> QString {
+			span.finish();
+			auto [http_code, json] = handleResponse("GET", url, response);
+
+			if (http_code != 200)
+				return "";
+
+			QJsonDocument doc = QJsonDocument::fromJson(json);
+			if (!doc.isObject())
+				return "";
 
-	return RunTaskSafe(&threadPool, "TwitchAuth/getGameId", [this, url]() mutable -> QString {
-		auto [http_code, json] = performGETSync(url, accessToken);
+			QJsonArray arr = doc["data"].toArray();
+			QString gameId = arr.isEmpty() ? QString() : arr.first().toObject()["id"].toString();
+			gameIdCache.store(gameName, gameId);
+			return gameId;
+		});
+}
 
-		if (http_code != 200)
-			return "";
+void TwitchAuthManager::prewarmGameIds(const QStringList &gameNames)
+{
+	if (!hasUsableToken() || ConfigManager::get().getActionMode() == 0)
+		return;
 
-		QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
-		if (!doc.isObject())
-			return "";
+	QStringList pending;
+	QSet<QString> seen;
+	for (const QString &gameName : gameNames) {
+		QString key = CategoryCache::normalize(gameName);
+		if (key.isEmpty() || seen.contains(key))
+			continue;
+		seen.insert(key);
+		if (!gameIdCache.contains(gameName))
+			pending.append(gameName);
+	}
 
-		QJsonArray arr = doc["data"].toArray();
-		if (arr.isEmpty())
-			return "";
+	if (pending.isEmpty())
+		return;
 
-		return arr.first().toObject()["id"].toString();
-	});
+	blog(LOG_INFO, "[GameDetector/TwitchAuth] Prewarming Twitch game IDs for %d games.",
+	     static_cast<int>(pending.size()));
+	prewarmBatch(pending, ++prewarmGeneration);
 }
 
-QFuture<TwitchAuthManager::UpdateResult> TwitchAuthManager::updateChannelCategory(const QString &gameId)
+void TwitchAuthManager::prewarmBatch(const QStringList &pending, int generation)
 {
-	QString url = "https://api.twitch.tv/helix/channels?broadcaster_id=" + userId;
+	if (generation != prewarmGeneration || accessToken.isEmpty())
+		return;
 
-	QJsonObject body;
-	body["game_id"] = gameId;
+	QStringList batch = pending.mid(0, PREWARM_BATCH_SIZE);
+	QStringList remaining = pending.mid(batch.size());
+
+	QStringList params;
+	for (const QString &gameName : batch)
+		params.append("name=" + QUrl::toPercentEncoding(gameName));
+	// Background work, so it yields the rate limit budget to lookups the user is waiting for.
+	NetworkRequest request = buildRequest(ApiEndpoint::TwitchGames, accessToken, params.join("&"));
+	request.priority = NetworkRequest::Priority::Low;
+	QString url = request.url;
+
+	NetworkEngine::get().submit(request, [this, url, batch, remaining, generation](const NetworkResponse &response) {
+		auto [http_code, json] = handleResponse("GET", url, response);
+		if (http_code != 200) {
+			blog(LOG_WARNING, "[GameDetector/TwitchAuth] Game ID prewarm stopped (Status: %ld).", http_code);
+			return;
+		}
 
-	return RunTaskSafe(&threadPool, "TwitchAuth/updateChannelCategory",
-			   [this, url, body]() mutable -> UpdateResult {
-				   auto [http_code, json] = performPATCHSync(url, body, accessToken);
-
-				   if (http_code == 204) {
-					   return UpdateResult::Success;
-				   } else if (http_code == 401) {
-					   return UpdateResult::AuthError;
-				   }
-				   return UpdateResult::Failed;
-			   });
+		// Names Helix does not return are cached as not found, like a single lookup would.
+		QHash<QString, QString> requested;
+		QHash<QString, QString> ids;
+		for (const QString &gameName : batch) {
+			requested.insert(CategoryCache::normalize(gameName), gameName);
+			ids.insert(gameName, QString());
+		}
+
+		QJsonArray arr = QJsonDocument::fromJson(json).object()["data"].toArray();
+		for (const QJsonValue &value : arr) {
+			QJsonObject game = value.toObject();
+			QString gameName = requested.value(CategoryCache::normalize(game["name"].toString()));
+			if (!gameName.isEmpty())
+				ids.insert(gameName, game["id"].toString());
+		}
+		// Written once when the last batch is in; a prewarm cut short is saved with the next store
+		// or at shutdown.
+		gameIdCache.storeBatch(ids, remaining.isEmpty());
+
+		if (remaining.isEmpty()) {
+			blog(LOG_INFO, "[GameDetector/TwitchAuth] Twitch game ID prewarm finished.");
+			return;
+		}
+
+		QMetaObject::invokeMethod(
+			this,
+			[this, remaining, generation]() {
+				QTimer::singleShot(PREWARM_BATCH_INTERVAL_MS, this,
+						   [this, remaining, generation]() { prewarmBatch(remaining, generation); });
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+QFuture<TwitchAuthManager::UpdateResult> TwitchAuthManager::updateChannelCategory(const QString &gameId)
+{
+	return updateChannelCategory(gameId, QString());
 }
 
 QFuture<TwitchAuthManager::UpdateResult> TwitchAuthManager::updateChannelCategory(const QString &gameId,
 										  const QString &title)
 {
-	QString url = "https://api.twitch.tv/helix/channels?broadcaster_id=" + userId;
+	if (!hasUsableToken())
+		return MakeReadyFuture(UpdateResult::AuthError);
 
 	QJsonObject body;
 	body["game_id"] = gameId;
 	if (!title.isEmpty())
 		body["title"] = title;
 
-	return RunTaskSafe(&threadPool, "TwitchAuth/updateChannelCategory",
-			   [this, url, body]() mutable -> UpdateResult {
-				   auto [http_code, json] = performPATCHSync(url, body, accessToken);
-
-				   if (http_code == 204) {
-					   return UpdateResult::Success;
-				   } else if (http_code == 401) {
-					   return UpdateResult::AuthError;
-				   }
-				   return UpdateResult::Failed;
-			   });
+	AsyncTraceSpan span("TwitchAuth/updateChannelCategory", "twitch");
+	NetworkRequest request =
+		buildRequest(ApiEndpoint::TwitchChannelUpdate, accessToken, "broadcaster_id=" + userId, body);
+	QString url = request.url;
+
+	return NetworkEngine::get().submitMapped<UpdateResult>(
+		request, "TwitchAuth/updateChannelCategory",
+		[this, url, span](const NetworkResponse &response) -> UpdateResult {
+			span.finish();
+			auto [http_code, json] = handleResponse("PATCH", url, response);
+
+			if (http_code == 204) {
+				return UpdateResult::Success;
+			} else if (http_code == 401) {
+				return UpdateResult::AuthError;
+			}
+			return UpdateResult::Failed;
+		});
 }
 
 QFuture<bool> TwitchAuthManager::sendChatMessage(const QString &broadcasterId, const QString &senderId,
@@ -417,184 +646,96 @@ QFuture<bool> TwitchAuthManager::sendChatMessage(const QString &broadcasterId, c
 {
 	if (broadcasterId.isEmpty() || senderId.isEmpty() || message.isEmpty()) {
 		blog(LOG_WARNING, "[GameDetector/TwitchAuth] Attempt to send chat message with incomplete data.");
-		QFuture<bool> future = QtConcurrent::run(&threadPool, [=]() { return false; });
-		return future;
+		return MakeReadyFuture(false);
 	}
-
-	QString url = "https://api.twitch.tv/helix/chat/messages";
+	if (!hasUsableToken())
+		return MakeReadyFuture(false);
 
 	QJsonObject body;
 	body["broadcaster_id"] = broadcasterId;
 	body["sender_id"] = senderId;
 	body["message"] = message;
 
-	return RunTaskSafe(&threadPool, "TwitchAuth/sendChatMessage", [this, url, body]() mutable -> bool {
-		auto [http_code, json] = performPOSTSync(url, body, accessToken);
-		return http_code == 200;
-	});
+	NetworkRequest request = buildRequest(ApiEndpoint::TwitchChatMessage, accessToken, QString(), body);
+	QString url = request.url;
+
+	return NetworkEngine::get().submitMapped<bool>(request, "TwitchAuth/sendChatMessage",
+						       [this, url](const NetworkResponse &response) -> bool {
+							       auto [http_code, json] =
+								       handleResponse("POST", url, response);
+							       return http_code == 200;
+						       });
 }
 
-std::pair<long, QString> TwitchAuthManager::performGETSync(const QString &url, const QString &token)
+ChannelState TwitchAuthManager::parseChannelState(const QString &url, const NetworkResponse &response)
 {
-	struct curl_slist *headers = nullptr;
-
-	std::string auth = "Authorization: Bearer " + token.toStdString();
-	std::string cid = "Client-ID: " + getClientId().toStdString();
-
-	headers = curl_slist_append(headers, auth.c_str());
-	headers = curl_slist_append(headers, cid.c_str());
+	ChannelState state;
+	auto [http_code, json] = handleResponse("GET", url, response);
+
+	QJsonDocument doc = QJsonDocument::fromJson(json);
+	if (http_code != 200) {
+		QString message = doc.isObject() ? doc.object()["message"].toString() : QString();
+		state.category = message.isEmpty() ? QString("Erro: HTTP %1").arg(http_code) : "Erro: " + message;
+		return state;
+	}
 
-	auto [http_code, response] = ExecuteNetworkRequest(url, "GET", headers);
-	curl_slist_free_all(headers);
+	if (!doc.isObject()) {
+		state.category = "Erro: Resposta da API inválida";
+		return state;
+	}
 
-	if (http_code < 200 || http_code >= 300) {
-		if (http_code == 401) {
-			blog(LOG_WARNING,
-			     "[GameDetector/TwitchAuth] Invalid token (401 Unauthorized) in GET request to %s. Initiating reauthentication process.",
-			     url.toStdString().c_str());
-			emit authenticationDataNeedsClearing();
-			emit reauthenticationNeeded();
-			return {http_code, ""};
-		} else if (http_code == 429) {
-			blog(LOG_WARNING,
-			     "[GameDetector/TwitchAuth] Twitch API rate limit exceeded (429 Too Many Requests). Please wait a moment and try again.");
-		}
-		blog(LOG_WARNING, "[GameDetector/TwitchAuth] Error in GET request to Twitch API (Status: %ld): %s",
-		     http_code, response.toStdString().c_str());
+	QJsonArray arr = doc["data"].toArray();
+	if (arr.isEmpty()) {
+		state.category = "Erro: Canal não encontrado";
+		return state;
 	}
 
-	return {http_code, response};
+	QJsonObject channel = arr.first().toObject();
+	state.category = channel["game_name"].toString();
+	state.title = channel.value("title").toString();
+	state.valid = true;
+	return state;
 }
 
-QFuture<QString> TwitchAuthManager::getChannelCategory()
+QFuture<ChannelState> TwitchAuthManager::getChannelState()
 {
-	if (userId.isEmpty()) {
-		return QtConcurrent::run(&threadPool, []() { return QString(); });
+	if (userId.isEmpty() || !hasUsableToken()) {
+		return MakeReadyFuture(ChannelState());
 	}
 
-	QString url = "https://api.twitch.tv/helix/channels?broadcaster_id=" + userId;
-
-	return RunTaskSafe(&threadPool, "TwitchAuth/getChannelCategory", [this, url]() mutable -> QString {
-		auto [http_code, json] = performGETSync(url, accessToken);
-
-		if (http_code != 200) {
-			QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
-			if (doc.isObject()) {
-				QString message = doc.object()["message"].toString();
-				if (!message.isEmpty()) {
-					return "Erro: " + message;
-				}
-			}
-			return QString("Erro: HTTP %1").arg(http_code);
-		}
-
-		QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
-		if (!doc.isObject())
-			return "Erro: Resposta da API inválida";
-
-		QJsonArray arr = doc["data"].toArray();
-		if (arr.isEmpty())
-			return "Erro: Canal não encontrado";
+	// Polling for the dock; the endpoint's Low priority yields the rate limit budget to updates.
+	NetworkRequest request = buildRequest(ApiEndpoint::TwitchChannel, accessToken, "broadcaster_id=" + userId);
+	QString url = request.url;
 
-		return arr.first().toObject()["game_name"].toString();
-	});
+	return NetworkEngine::get().submitMapped<ChannelState>(
+		request, "TwitchAuth/getChannelState",
+		[this, url](const NetworkResponse &response) { return parseChannelState(url, response); });
 }
 
-QFuture<QString> TwitchAuthManager::getChannelTitle()
+QFuture<QString> TwitchAuthManager::getChannelCategory()
 {
 	if (userId.isEmpty()) {
-		return QtConcurrent::run(&threadPool, []() { return QString(); });
+		return MakeReadyFuture(QString());
 	}
 
-	QString url = "https://api.twitch.tv/helix/channels?broadcaster_id=" + userId;
-
-	return RunTaskSafe(&threadPool, "TwitchAuth/getChannelTitle", [this, url]() mutable -> QString {
-		auto [http_code, json] = performGETSync(url, accessToken);
-
-		if (http_code != 200) {
-			return QString();
-		}
-
-		QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
-		if (!doc.isObject())
-			return QString();
-
-		QJsonArray arr = doc["data"].toArray();
-		if (arr.isEmpty())
-			return QString();
+	NetworkRequest request = buildRequest(ApiEndpoint::TwitchChannel, accessToken, "broadcaster_id=" + userId);
+	QString url = request.url;
 
-		return arr.first().toObject().value("title").toString();
-	});
+	return NetworkEngine::get().submitMapped<QString>(
+		request, "TwitchAuth/getChannelCategory",
+		[this, url](const NetworkResponse &response) { return parseChannelState(url, response).category; });
 }
 
-std::pair<long, QString> TwitchAuthManager::performPATCHSync(const QString &url, const QJsonObject &body,
-							     const QString &token)
+QFuture<QString> TwitchAuthManager::getChannelTitle()
 {
-	struct curl_slist *headers = nullptr;
-	std::string auth = "Authorization: Bearer " + token.toStdString();
-	std::string cid = "Client-ID: " + getClientId().toStdString();
-
-	headers = curl_slist_append(headers, auth.c_str());
-	headers = curl_slist_append(headers, cid.c_str());
-	headers = curl_slist_append(headers, "Content-Type: application/json");
-
-	QJsonDocument doc(body);
-	std::string json = doc.toJson(QJsonDocument::Compact).toStdString();
-
-	auto [http_code, response] = ExecuteNetworkRequest(url, "PATCH", headers, json);
-	curl_slist_free_all(headers);
-
-	if (http_code < 200 || http_code >= 300) {
-		if (http_code == 401) {
-			blog(LOG_WARNING,
-			     "[GameDetector/TwitchAuth] Invalid token (401 Unauthorized) in PATCH request to %s. Initiating reauthentication process.",
-			     url.toStdString().c_str());
-			emit authenticationDataNeedsClearing();
-			emit reauthenticationNeeded();
-			return {http_code, ""};
-		} else if (http_code == 429) {
-			blog(LOG_WARNING,
-			     "[GameDetector/TwitchAuth] Twitch API rate limit exceeded (429 Too Many Requests). Please wait a moment and try again.");
-		}
-		blog(LOG_WARNING, "[GameDetector/TwitchAuth] Error in PATCH request to Twitch API (Status: %ld): %s",
-		     http_code, response.toStdString().c_str());
+	if (userId.isEmpty()) {
+		return MakeReadyFuture(QString());
 	}
 
-	return {http_code, response};
-}
-
-std::pair<long, QString> TwitchAuthManager::performPOSTSync(const QString &url, const QJsonObject &body,
-							    const QString &token)
-{
-	struct curl_slist *headers = nullptr;
-	std::string auth = "Authorization: Bearer " + token.toStdString();
-	std::string cid = "Client-ID: " + getClientId().toStdString();
-
-	headers = curl_slist_append(headers, auth.c_str());
-	headers = curl_slist_append(headers, cid.c_str());
-	headers = curl_slist_append(headers, "Content-Type: application/json");
-
-	QJsonDocument doc(body);
-	std::string json = doc.toJson(QJsonDocument::Compact).toStdString();
-
-	auto [http_code, response] = ExecuteNetworkRequest(url, "POST", headers, json);
-	curl_slist_free_all(headers);
-
-	if (http_code < 200 || http_code >= 300) {
-		if (http_code == 401) {
-			blog(LOG_WARNING,
-			     "[GameDetector/TwitchAuth] Invalid token (401 Unauthorized) in POST request to %s. Initiating reauthentication process.",
-			     url.toStdString().c_str());
-			emit authenticationDataNeedsClearing();
-			emit reauthenticationNeeded();
-			return {http_code, ""};
-		} else if (http_code == 429) {
-			blog(LOG_WARNING,
-			     "[GameDetector/TwitchAuth] Twitch API rate limit exceeded (429 Too Many Requests). Please wait a moment and try again.");
-		}
-		blog(LOG_WARNING, "[GameDetector/TwitchAuth] Error in POST request to Twitch API (Status: %ld): %s",
-		     http_code, response.toStdString().c_str());
-	}
+	NetworkRequest request = buildRequest(ApiEndpoint::TwitchChannel, accessToken, "broadcaster_id=" + userId);
+	QString url = request.url;
 
-	return {http_code, response};
+	return NetworkEngine::get().submitMapped<QString>(
+		request, "TwitchAuth/getChannelTitle",
+		[this, url](const NetworkResponse &response) { return parseChannelState(url, response).title; });
 }
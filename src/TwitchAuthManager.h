@@ -7,9 +7,14 @@
 #include <QString>
 #include <QFuture>
 #include <QJsonObject>
-#include <QThreadPool>
 #include <QPointer>
 #include <QList>
+#include <QDateTime>
+
+#include "CategoryCache.h"
+#include "IPlatformService.h"
+#include "NetworkEngine.h"
+#include "ApiEndpoints.h"
 
 class QTcpServer;
 class QTcpSocket;
@@ -34,12 +39,20 @@ public:
 	std::pair<QString, QString> getTokenUserInfo();
 
 	QFuture<QString> getGameId(const QString &gameName);
+	bool getCachedGameId(const QString &gameName, QString *gameId);
+	void prewarmGameIds(const QStringList &gameNames);
 	QFuture<UpdateResult> updateChannelCategory(const QString &gameId);
 	QFuture<QString> getChannelTitle();
 	QFuture<UpdateResult> updateChannelCategory(const QString &gameId, const QString &title);
 	QFuture<bool> sendChatMessage(const QString &broadcasterId, const QString &senderId, const QString &message);
 
 	QFuture<QString> getChannelCategory();
+	QFuture<ChannelState> getChannelState();
+
+	// False once the token is known to be invalid or past its expiry, so callers fail fast
+	// instead of sending a request that can only end in a 401.
+	bool hasUsableToken() const;
+	void validateToken();
 
 signals:
 	void authenticationFinished(bool success, const QString &info);
@@ -61,15 +74,16 @@ private:
 	TwitchAuthManager(QObject *parent = nullptr);
 	~TwitchAuthManager();
 
-	QFuture<std::pair<long, QString>> performGET(const QString &url, const QString &token);
-	QFuture<std::pair<long, QString>> performPATCH(const QString &url, const QJsonObject &body,
-						       const QString &token);
-	QFuture<std::pair<long, QString>> performPOST(const QString &url, const QJsonObject &body,
-						      const QString &token);
+	NetworkRequest buildRequest(ApiEndpoint endpoint, const QString &token, const QString &query = QString(),
+				    const QJsonObject &body = QJsonObject()) const;
+	std::pair<long, QByteArray> handleResponse(const char *method, const QString &url,
+						const NetworkResponse &response);
 
-	std::pair<long, QString> performGETSync(const QString &url, const QString &token);
-	std::pair<long, QString> performPATCHSync(const QString &url, const QJsonObject &body, const QString &token);
-	std::pair<long, QString> performPOSTSync(const QString &url, const QJsonObject &body, const QString &token);
+	std::pair<long, QByteArray> performGETSync(ApiEndpoint endpoint, const QString &token);
+	void prewarmBatch(const QStringList &pending, int generation);
+	ChannelState parseChannelState(const QString &url, const NetworkResponse &response);
+	void onTokenValidated(const QString &token, long httpCode, const QByteArray &body);
+	void invalidateToken(const char *reason);
 
 	QString accessToken;
 	QString userId;
@@ -78,11 +92,26 @@ private:
 	QTcpServer *server = nullptr;
 	QTimer *authTimeoutTimer = nullptr;
 	int authRemainingSeconds = 0;
-	QThreadPool threadPool;
 	QList<QPointer<QTcpSocket>> clientSockets;
+	CategoryCache gameIdCache;
+	mutable RequestTemplateCache requestTemplates;
+	// Attached to every request so shutdown() can abort them all at once.
+	CancellationToken requestLifetime = CancellationToken::create();
+	int prewarmGeneration = 0;
+
+	enum class TokenState { Unknown, Valid, Invalid };
+	TokenState tokenState = TokenState::Unknown;
+	QDateTime tokenExpiresAt;
+	bool renewalRequested = false;
+	QTimer *tokenValidationTimer = nullptr;
 
 	static constexpr const char *CLIENT_ID = "wl4mx2l4sgmdvpwoek6pjronpor9en";
 	static constexpr const char *REDIRECT_URI = "http://localhost:30000/";
+	static constexpr int PREWARM_BATCH_SIZE = 100;
+	static constexpr int PREWARM_BATCH_INTERVAL_MS = 1000;
+	// Twitch asks apps to validate their tokens at least once an hour.
+	static constexpr int TOKEN_VALIDATION_INTERVAL_MS = 60 * 60 * 1000;
+	static constexpr qint64 TOKEN_RENEWAL_MARGIN_SECONDS = 24 * 60 * 60;
 };
 
 #endif // TWITCHAUTHMANAGER_H
@@ -38,7 +38,7 @@ TwitchServiceAdapter::TwitchServiceAdapter(QObject *parent) : IPlatformService(p
 
 bool TwitchServiceAdapter::isAuthenticated() const
 {
-	return !TwitchAuthManager::get().getAccessToken().isEmpty();
+	return TwitchAuthManager::get().hasUsableToken();
 }
 
 void TwitchServiceAdapter::updateCategory(const QString &gameName, const QString &title)
@@ -64,11 +64,28 @@ void TwitchServiceAdapter::updateCategory(const QString &gameName, const QString
 		return;
 	}
 
+	QString cachedId;
+	if (TwitchAuthManager::get().getCachedGameId(gameName, &cachedId)) {
+		if (cachedId.isEmpty()) {
+			emit categoryUpdateFinished(false, gameName, obs_module_text("Twitch.Error.GameNotFound"));
+			return;
+		}
+		updateWatcher->setProperty("gameName", gameName);
+		updateWatcher->setProperty("title", title);
+		updateWatcher->setFuture(TwitchAuthManager::get().updateChannelCategory(cachedId, title));
+		return;
+	}
+
 	gameIdWatcher->setProperty("gameName", gameName);
 	gameIdWatcher->setProperty("title", title);
 	gameIdWatcher->setFuture(TwitchAuthManager::get().getGameId(gameName));
 }
 
+QFuture<ChannelState> TwitchServiceAdapter::getChannelState()
+{
+	return TwitchAuthManager::get().getChannelState();
+}
+
 void TwitchServiceAdapter::sendChatMessage(const QString &message)
 {
 	QString uid = TwitchAuthManager::get().getUserId();
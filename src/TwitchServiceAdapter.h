@@ -7,9 +7,12 @@ class TwitchServiceAdapter : public IPlatformService {
 	Q_OBJECT
 public:
 	explicit TwitchServiceAdapter(QObject *parent = nullptr);
+	QString platformId() const override { return "Twitch"; }
+	int capabilities() const override { return UpdateCategory | UpdateTitle | SendChat | ReadChannelState; }
 	void updateCategory(const QString &gameName, const QString &title = QString()) override;
 	void sendChatMessage(const QString &message) override;
 	bool isAuthenticated() const override;
+	QFuture<ChannelState> getChannelState() override;
 
 private:
 	QFutureWatcher<QString> *gameIdWatcher;
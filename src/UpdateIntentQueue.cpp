@@ -0,0 +1,170 @@
+#include "UpdateIntentQueue.h"
+#include "CategoryCache.h"
+#include "ConfigManager.h"
+
+#include <obs-module.h>
+#include <obs-data.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+
+UpdateIntentQueue::UpdateIntentQueue(const char *fileName) : fileName(fileName) {}
+
+void UpdateIntentQueue::record(const QString &platform, const QString &category, const QString &title)
+{
+	ensureLoaded();
+
+	Intent intent;
+	intent.category = category;
+	intent.title = title;
+	intent.createdAt = QDateTime::currentSecsSinceEpoch();
+	intents.insert(platform, intent);
+	save();
+}
+
+void UpdateIntentQueue::resolve(const QString &platform, const QString &category)
+{
+	ensureLoaded();
+
+	auto it = intents.find(platform);
+	if (it == intents.end() || CategoryCache::normalize(it.value().category) != CategoryCache::normalize(category))
+		return;
+	intents.erase(it);
+	save();
+}
+
+void UpdateIntentQueue::drop(const QString &platform)
+{
+	ensureLoaded();
+	if (intents.remove(platform) > 0)
+		save();
+}
+
+bool UpdateIntentQueue::pending(const QString &platform, Intent *intent)
+{
+	ensureLoaded();
+	expire();
+
+	auto it = intents.constFind(platform);
+	if (it == intents.cend())
+		return false;
+	if (intent)
+		*intent = it.value();
+	return true;
+}
+
+int UpdateIntentQueue::countReplay(const QString &platform)
+{
+	ensureLoaded();
+
+	auto it = intents.find(platform);
+	if (it == intents.end())
+		return 0;
+	int replays = ++it.value().replays;
+	save();
+	return replays;
+}
+
+QStringList UpdateIntentQueue::platforms()
+{
+	ensureLoaded();
+	expire();
+	return intents.keys();
+}
+
+bool UpdateIntentQueue::isEmpty()
+{
+	ensureLoaded();
+	expire();
+	return intents.isEmpty();
+}
+
+void UpdateIntentQueue::expire()
+{
+	qint64 cutoff = QDateTime::currentSecsSinceEpoch() - MAX_AGE_SECONDS;
+	bool changed = false;
+	for (auto it = intents.begin(); it != intents.end();) {
+		if (it.value().createdAt < cutoff) {
+			blog(LOG_INFO, "[GameDetector/UpdateIntentQueue] Discarding stale %s update to '%s'.",
+			     it.key().toStdString().c_str(), it.value().category.toStdString().c_str());
+			it = intents.erase(it);
+			changed = true;
+		} else {
+			++it;
+		}
+	}
+	if (changed)
+		save();
+}
+
+void UpdateIntentQueue::ensureLoaded()
+{
+	// Intents recorded against a stand-in are kept apart from the production ones.
+	QString stateFileName = ConfigManager::get().getApiStateFileName(fileName);
+	if (stateFileName == loadedFileName)
+		return;
+	intents.clear();
+	loadedFileName = stateFileName;
+
+	char *path = obs_module_config_path(loadedFileName.toUtf8().constData());
+	if (!path)
+		return;
+	obs_data_t *data = obs_data_create_from_json_file(path);
+	bfree(path);
+	if (!data)
+		return;
+
+	obs_data_array_t *items = obs_data_get_array(data, "intents");
+	for (size_t i = 0; i < obs_data_array_count(items); ++i) {
+		obs_data_t *item = obs_data_array_item(items, i);
+		Intent intent;
+		intent.category = QString::fromUtf8(obs_data_get_string(item, "category"));
+		intent.title = QString::fromUtf8(obs_data_get_string(item, "title"));
+		intent.createdAt = obs_data_get_int(item, "created_at");
+		intent.replays = static_cast<int>(obs_data_get_int(item, "replays"));
+		QString platform = QString::fromUtf8(obs_data_get_string(item, "platform"));
+		if (!platform.isEmpty() && !intent.category.isEmpty())
+			intents.insert(platform, intent);
+		obs_data_release(item);
+	}
+	obs_data_array_release(items);
+	obs_data_release(data);
+
+	if (!intents.isEmpty()) {
+		blog(LOG_INFO, "[GameDetector/UpdateIntentQueue] Loaded %d unconfirmed category updates.",
+		     static_cast<int>(intents.size()));
+	}
+}
+
+void UpdateIntentQueue::save()
+{
+	char *path = obs_module_config_path(loadedFileName.toUtf8().constData());
+	if (!path)
+		return;
+
+	QDir dir = QFileInfo(QString::fromUtf8(path)).dir();
+	if (!dir.exists())
+		dir.mkpath(".");
+
+	obs_data_t *data = obs_data_create();
+	obs_data_array_t *items = obs_data_array_create();
+	for (auto it = intents.cbegin(); it != intents.cend(); ++it) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "platform", it.key().toUtf8().constData());
+		obs_data_set_string(item, "category", it.value().category.toUtf8().constData());
+		obs_data_set_string(item, "title", it.value().title.toUtf8().constData());
+		obs_data_set_int(item, "created_at", it.value().createdAt);
+		obs_data_set_int(item, "replays", it.value().replays);
+		obs_data_array_push_back(items, item);
+		obs_data_release(item);
+	}
+	obs_data_set_array(data, "intents", items);
+	obs_data_array_release(items);
+
+	if (!obs_data_save_json_safe(data, path, "tmp", "bak"))
+		blog(LOG_WARNING, "[GameDetector/UpdateIntentQueue] Failed to save pending updates to: %s", path);
+
+	obs_data_release(data);
+	bfree(path);
+}
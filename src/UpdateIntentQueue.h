@@ -0,0 +1,48 @@
+#ifndef UPDATEINTENTQUEUE_H
+#define UPDATEINTENTQUEUE_H
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+// Category and title the user last asked for on each platform, kept in a JSON file under the
+// module config directory until the platform confirms them. A newer request for a platform
+// replaces the older one, so only the latest desired state is ever replayed.
+class UpdateIntentQueue {
+public:
+	struct Intent {
+		QString category;
+		QString title;
+		qint64 createdAt = 0;
+		int replays = 0;
+	};
+
+	explicit UpdateIntentQueue(const char *fileName);
+
+	void record(const QString &platform, const QString &category, const QString &title);
+	// Drops the platform's intent if it still asks for category. A newer intent is kept.
+	void resolve(const QString &platform, const QString &category);
+	void drop(const QString &platform);
+	bool pending(const QString &platform, Intent *intent);
+	// Counts a replay and returns the new total.
+	int countReplay(const QString &platform);
+	QStringList platforms();
+	bool isEmpty();
+
+	// Intents older than this are discarded; the game has most likely changed since.
+	static constexpr qint64 MAX_AGE_SECONDS = 60 * 60;
+
+private:
+	void ensureLoaded();
+	void save();
+	void expire();
+
+	const char *fileName;
+	QHash<QString, Intent> intents;
+	// File the intents were read from, empty until the first access.
+	QString loadedFileName;
+};
+
+#endif // UPDATEINTENTQUEUE_H